@@ -0,0 +1,421 @@
+#include "FlowFieldSubsystem.h"
+#include "Destructibles/DestructibleTarget.h"
+#include "Destructibles/DestructibleField.h"
+#include "Systems/HibernationSubsystem.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlowField Lookup"), STAT_FlowFieldLookup, STATGROUP_Game);
+
+namespace
+{
+	// 4 straight neighbours first, then diagonals
+	const FIntPoint Neighbours[8] = {
+		FIntPoint(1, 0), FIntPoint(-1, 0), FIntPoint(0, 1), FIntPoint(0, -1),
+		FIntPoint(1, 1), FIntPoint(1, -1), FIntPoint(-1, 1), FIntPoint(-1, -1)
+	};
+	const float StepLength[8] = { 1.f, 1.f, 1.f, 1.f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f };
+
+	const FName ObstacleTag(TEXT("FlowObstacle"));
+
+	// Diagonal moves may not cut past a blocked corner
+	bool CanStep(const FFlowFieldGrid& Grid, int32 X, int32 Y, int32 Dir)
+	{
+		const int32 NX = X + Neighbours[Dir].X;
+		const int32 NY = Y + Neighbours[Dir].Y;
+		if (!Grid.IsValidCell(NX, NY) || Grid.Cost[Grid.ToIndex(NX, NY)] == FFlowFieldGrid::Blocked) return false;
+		if (Dir < 4) return true;
+		return Grid.Cost[Grid.ToIndex(NX, Y)] != FFlowFieldGrid::Blocked
+			&& Grid.Cost[Grid.ToIndex(X, NY)] != FFlowFieldGrid::Blocked;
+	}
+
+	bool HeapLess(const TPair<float, int32>& A, const TPair<float, int32>& B)
+	{
+		return A.Key < B.Key;
+	}
+}
+
+FIntPoint FFlowFieldGrid::WorldToCell(const FVector& Location) const
+{
+	return FIntPoint(
+		FMath::FloorToInt((Location.X - Origin.X) / CellSize),
+		FMath::FloorToInt((Location.Y - Origin.Y) / CellSize));
+}
+
+FVector FFlowFieldGrid::CellToWorld(const FIntPoint& Cell) const
+{
+	return FVector(Origin.X + (Cell.X + 0.5f) * CellSize, Origin.Y + (Cell.Y + 0.5f) * CellSize, 0.f);
+}
+
+bool UFlowFieldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlowFieldSubsystem, STATGROUP_Tickables);
+}
+
+void UFlowFieldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Start with an open grid; obstacles are rasterized on the first rebuild
+	TSharedPtr<FFlowFieldGrid> Open = MakeShared<FFlowFieldGrid>();
+	Open->CellSize = CellSize;
+	Open->SizeX = GridCells;
+	Open->SizeY = GridCells;
+	Open->Origin = FVector2D(-GridCells * CellSize * 0.5f);
+	Open->Cost.Init(1, GridCells * GridCells);
+	Grid = Open;
+}
+
+void UFlowFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// One walk over the level for tagged geometry - static bounds never change
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		if (!It->ActorHasTag(ObstacleTag)) continue;
+
+		if (It->IsRootComponentMovable())
+		{
+			MovableObstacles.Add(*It);
+		}
+		else
+		{
+			StaticObstacles.Add(It->GetComponentsBoundingBox());
+		}
+	}
+	bObstaclesDirty = true;
+}
+
+void UFlowFieldSubsystem::Deinitialize()
+{
+	if (bBuildInFlight)
+	{
+		BuildTask.Wait();
+		bBuildInFlight = false;
+	}
+	Super::Deinitialize();
+}
+
+void UFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	if (bBuildInFlight && BuildTask.IsCompleted())
+	{
+		FBuildResult& Result = BuildTask.GetResult();
+		Grid = Result.Grid;
+		for (const TSharedPtr<const FFlowField>& Field : Result.Fields)
+		{
+			Fields.Add(Field->Goal, Field);
+		}
+		bBuildInFlight = false;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (!bBuildInFlight && (bObstaclesDirty || RequestedGoals.Num() > 0) && Now - LastBuildTime >= RebuildInterval)
+	{
+		StartBuild();
+	}
+}
+
+bool UFlowFieldSubsystem::GetFlowDirection(const FVector& Goal, const FVector& From, FVector& OutDirection)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlowFieldLookup);
+
+	const FIntPoint GoalCell = Grid->WorldToCell(Goal);
+	const FIntPoint FromCell = Grid->WorldToCell(From);
+	if (!Grid->IsValidCell(GoalCell.X, GoalCell.Y) || !Grid->IsValidCell(FromCell.X, FromCell.Y)) return false;
+
+	// A goal moving within its block keeps using the same field
+	const int32 Snap = FMath::Max(1, GoalSnapCells);
+	const FIntPoint GoalKey(GoalCell.X / Snap, GoalCell.Y / Snap);
+	FieldLastUsed.Add(GoalKey, GetWorld()->GetTimeSeconds());
+
+	const TSharedPtr<const FFlowField>* Field = Fields.Find(GoalKey);
+	if (!Field)
+	{
+		RequestedGoals.Add(GoalKey);
+		return false;
+	}
+
+	const uint8 Dir = (*Field)->Direction[Grid->ToIndex(FromCell.X, FromCell.Y)];
+	if (Dir == FFlowField::NoDirection) return false;
+
+	// Aim at the next cell's center rather than the raw 8-way direction for smoother steering
+	const FVector Target = Grid->CellToWorld(FromCell + Neighbours[Dir]);
+	OutDirection = (Target - From).GetSafeNormal2D();
+	return !OutDirection.IsNearlyZero();
+}
+
+void UFlowFieldSubsystem::GatherObstacles(TArray<FBox>& OutBoxes) const
+{
+	UWorld* World = GetWorld();
+
+	// Intact destructibles block; debris is pushed through
+	for (TActorIterator<ADestructibleTarget> It(World); It; ++It)
+	{
+		if (IsValid(*It) && It->GetBreakDepth() == 0)
+		{
+			OutBoxes.Add(It->GetComponentsBoundingBox());
+		}
+	}
+
+	// Hibernated far from players, but still in the way
+	if (const UHibernationSubsystem* Hibernation = World->GetSubsystem<UHibernationSubsystem>())
+	{
+		Hibernation->GetObstacleBounds(OutBoxes);
+	}
+
+	for (TActorIterator<ADestructibleField> It(World); It; ++It)
+	{
+		It->GetInstanceBounds(OutBoxes);
+	}
+
+	// Level geometry opts in with a tag (gathered at begin play)
+	OutBoxes.Append(StaticObstacles);
+	for (const TWeakObjectPtr<AActor>& Actor : MovableObstacles)
+	{
+		if (const AActor* Obstacle = Actor.Get())
+		{
+			OutBoxes.Add(Obstacle->GetComponentsBoundingBox());
+		}
+	}
+}
+
+void UFlowFieldSubsystem::StartBuild()
+{
+	// Drop least recently used fields so the background work stays bounded
+	while (Fields.Num() + RequestedGoals.Num() > MaxFields && Fields.Num() > 0)
+	{
+		FIntPoint Oldest = FIntPoint::NoneValue;
+		double OldestTime = TNumericLimits<double>::Max();
+		for (const TPair<FIntPoint, TSharedPtr<const FFlowField>>& Pair : Fields)
+		{
+			const double* Used = FieldLastUsed.Find(Pair.Key);
+			const double Time = Used ? *Used : 0.0;
+			if (Time < OldestTime)
+			{
+				OldestTime = Time;
+				Oldest = Pair.Key;
+			}
+		}
+		Fields.Remove(Oldest);
+		FieldLastUsed.Remove(Oldest);
+	}
+
+	const bool bRasterize = bObstaclesDirty;
+	TArray<FBox> Obstacles;
+	TArray<TSharedPtr<const FFlowField>> ToRepair;
+	if (bRasterize)
+	{
+		GatherObstacles(Obstacles);
+		for (const TPair<FIntPoint, TSharedPtr<const FFlowField>>& Pair : Fields)
+		{
+			ToRepair.Add(Pair.Value);
+		}
+	}
+
+	TArray<FIntPoint> NewGoals = RequestedGoals.Array();
+	RequestedGoals.Reset();
+
+	bObstaclesDirty = false;
+	bBuildInFlight = true;
+	LastBuildTime = GetWorld()->GetTimeSeconds();
+
+	const float Padding = ObstaclePadding;
+	const int32 GoalSnap = FMath::Max(1, GoalSnapCells);
+	BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[OldGrid = Grid, Obstacles = MoveTemp(Obstacles), ToRepair = MoveTemp(ToRepair), NewGoals = MoveTemp(NewGoals), bRasterize, Padding, GoalSnap]()
+		{
+			FBuildResult Result;
+
+			if (bRasterize)
+			{
+				TArray<FBox> Padded;
+				Padded.Reserve(Obstacles.Num());
+				for (const FBox& Box : Obstacles)
+				{
+					Padded.Add(Box.ExpandBy(FVector(Padding, Padding, 0.f)));
+				}
+				Result.Grid = RasterizeGrid(*OldGrid, Padded);
+			}
+			else
+			{
+				Result.Grid = OldGrid;
+			}
+
+			for (const TSharedPtr<const FFlowField>& Old : ToRepair)
+			{
+				Result.Fields.Add(RepairField(*OldGrid, *Result.Grid, *Old));
+			}
+			for (const FIntPoint& Goal : NewGoals)
+			{
+				Result.Fields.Add(ComputeField(*Result.Grid, Goal, GoalSnap));
+			}
+			return Result;
+		});
+}
+
+TSharedPtr<FFlowFieldGrid> UFlowFieldSubsystem::RasterizeGrid(const FFlowFieldGrid& Layout, const TArray<FBox>& Obstacles)
+{
+	TSharedPtr<FFlowFieldGrid> NewGrid = MakeShared<FFlowFieldGrid>();
+	NewGrid->Origin = Layout.Origin;
+	NewGrid->CellSize = Layout.CellSize;
+	NewGrid->SizeX = Layout.SizeX;
+	NewGrid->SizeY = Layout.SizeY;
+	NewGrid->Cost.Init(1, Layout.SizeX * Layout.SizeY);
+
+	for (const FBox& Box : Obstacles)
+	{
+		const FIntPoint Min = NewGrid->WorldToCell(Box.Min);
+		const FIntPoint Max = NewGrid->WorldToCell(Box.Max);
+		for (int32 Y = FMath::Max(0, Min.Y); Y <= FMath::Min(NewGrid->SizeY - 1, Max.Y); Y++)
+		{
+			for (int32 X = FMath::Max(0, Min.X); X <= FMath::Min(NewGrid->SizeX - 1, Max.X); X++)
+			{
+				NewGrid->Cost[NewGrid->ToIndex(X, Y)] = FFlowFieldGrid::Blocked;
+			}
+		}
+	}
+	return NewGrid;
+}
+
+TSharedPtr<FFlowField> UFlowFieldSubsystem::ComputeField(const FFlowFieldGrid& Layout, const FIntPoint& Goal, int32 GoalSnap)
+{
+	TSharedPtr<FFlowField> Field = MakeShared<FFlowField>();
+	Field->Goal = Goal;
+	Field->GoalMin = Goal * GoalSnap;
+	Field->GoalMax = Field->GoalMin + FIntPoint(GoalSnap - 1, GoalSnap - 1);
+	Field->Integration.Init(MAX_flt, Layout.Cost.Num());
+
+	TArray<TPair<float, int32>> Heap;
+	SeedGoal(Layout, *Field, Heap);
+
+	Integrate(Layout, *Field, Heap);
+	ComputeDirections(Layout, *Field);
+	return Field;
+}
+
+TSharedPtr<FFlowField> UFlowFieldSubsystem::RepairField(const FFlowFieldGrid& OldGrid, const FFlowFieldGrid& NewGrid, const FFlowField& OldField)
+{
+	// Any cell that got more expensive invalidates paths through it - start over
+	for (int32 i = 0; i < NewGrid.Cost.Num(); i++)
+	{
+		if (NewGrid.Cost[i] > OldGrid.Cost[i])
+		{
+			// Keep the block size the field was built with
+			return ComputeField(NewGrid, OldField.Goal, OldField.GoalMax.X - OldField.GoalMin.X + 1);
+		}
+	}
+
+	// Costs only dropped (obstacles destroyed) - reseed the changed cells and propagate from there
+	TSharedPtr<FFlowField> Field = MakeShared<FFlowField>(OldField);
+	TArray<TPair<float, int32>> Heap;
+
+	SeedGoal(NewGrid, *Field, Heap);
+
+	for (int32 Y = 0; Y < NewGrid.SizeY; Y++)
+	{
+		for (int32 X = 0; X < NewGrid.SizeX; X++)
+		{
+			const int32 Index = NewGrid.ToIndex(X, Y);
+			if (NewGrid.Cost[Index] == OldGrid.Cost[Index]) continue;
+
+			float Best = Field->Integration[Index];
+			for (int32 Dir = 0; Dir < 8; Dir++)
+			{
+				if (!CanStep(NewGrid, X, Y, Dir)) continue;
+				const float Neighbour = Field->Integration[NewGrid.ToIndex(X + Neighbours[Dir].X, Y + Neighbours[Dir].Y)];
+				if (Neighbour < MAX_flt)
+				{
+					Best = FMath::Min(Best, Neighbour + StepLength[Dir] * NewGrid.Cost[Index]);
+				}
+			}
+
+			if (Best < Field->Integration[Index])
+			{
+				Field->Integration[Index] = Best;
+				Heap.HeapPush(TPair<float, int32>(Best, Index), HeapLess);
+			}
+		}
+	}
+
+	Integrate(NewGrid, *Field, Heap);
+	ComputeDirections(NewGrid, *Field);
+	return Field;
+}
+
+void UFlowFieldSubsystem::SeedGoal(const FFlowFieldGrid& Layout, FFlowField& Field, TArray<TPair<float, int32>>& Heap)
+{
+	// Every open cell of the goal block is a source
+	for (int32 Y = FMath::Max(0, Field.GoalMin.Y); Y <= FMath::Min(Layout.SizeY - 1, Field.GoalMax.Y); Y++)
+	{
+		for (int32 X = FMath::Max(0, Field.GoalMin.X); X <= FMath::Min(Layout.SizeX - 1, Field.GoalMax.X); X++)
+		{
+			const int32 Index = Layout.ToIndex(X, Y);
+			if (Layout.Cost[Index] != FFlowFieldGrid::Blocked && Field.Integration[Index] > 0.f)
+			{
+				Field.Integration[Index] = 0.f;
+				Heap.HeapPush(TPair<float, int32>(0.f, Index), HeapLess);
+			}
+		}
+	}
+}
+
+void UFlowFieldSubsystem::Integrate(const FFlowFieldGrid& Layout, FFlowField& Field, TArray<TPair<float, int32>>& Heap)
+{
+	// Dijkstra over the 8-connected grid
+	while (Heap.Num() > 0)
+	{
+		TPair<float, int32> Top;
+		Heap.HeapPop(Top, HeapLess, EAllowShrinking::No);
+		if (Top.Key > Field.Integration[Top.Value]) continue;  // Stale entry
+
+		const int32 X = Top.Value % Layout.SizeX;
+		const int32 Y = Top.Value / Layout.SizeX;
+
+		for (int32 Dir = 0; Dir < 8; Dir++)
+		{
+			if (!CanStep(Layout, X, Y, Dir)) continue;
+
+			const int32 Next = Layout.ToIndex(X + Neighbours[Dir].X, Y + Neighbours[Dir].Y);
+			const float Candidate = Top.Key + StepLength[Dir] * Layout.Cost[Next];
+			if (Candidate < Field.Integration[Next])
+			{
+				Field.Integration[Next] = Candidate;
+				Heap.HeapPush(TPair<float, int32>(Candidate, Next), HeapLess);
+			}
+		}
+	}
+}
+
+void UFlowFieldSubsystem::ComputeDirections(const FFlowFieldGrid& Layout, FFlowField& Field)
+{
+	Field.Direction.Init(FFlowField::NoDirection, Layout.Cost.Num());
+
+	for (int32 Y = 0; Y < Layout.SizeY; Y++)
+	{
+		for (int32 X = 0; X < Layout.SizeX; X++)
+		{
+			const int32 Index = Layout.ToIndex(X, Y);
+			float Best = Field.Integration[Index];
+			if (Best >= MAX_flt) continue;
+
+			for (int32 Dir = 0; Dir < 8; Dir++)
+			{
+				if (!CanStep(Layout, X, Y, Dir)) continue;
+
+				const float Neighbour = Field.Integration[Layout.ToIndex(X + Neighbours[Dir].X, Y + Neighbours[Dir].Y)];
+				if (Neighbour < Best)
+				{
+					Best = Neighbour;
+					Field.Direction[Index] = (uint8)Dir;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "FlowFieldSubsystem.generated.h"
+
+// Uniform cost grid over the level (255 = blocked)
+struct FFlowFieldGrid
+{
+	static constexpr uint8 Blocked = 255;
+
+	FVector2D Origin = FVector2D::ZeroVector;  // World XY of cell (0,0)'s corner
+	float CellSize = 200.f;
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	TArray<uint8> Cost;
+
+	bool IsValidCell(int32 X, int32 Y) const { return X >= 0 && Y >= 0 && X < SizeX && Y < SizeY; }
+	int32 ToIndex(int32 X, int32 Y) const { return Y * SizeX + X; }
+	FIntPoint WorldToCell(const FVector& Location) const;
+	FVector CellToWorld(const FIntPoint& Cell) const;
+};
+
+// Integration and direction field toward one goal block of cells, shared by every bot chasing a goal in it
+struct FFlowField
+{
+	static constexpr uint8 NoDirection = 255;
+
+	FIntPoint Goal = FIntPoint::ZeroValue;     // Block key (goal cell / GoalSnapCells)
+	FIntPoint GoalMin = FIntPoint::ZeroValue;  // Cells of the block, inclusive
+	FIntPoint GoalMax = FIntPoint::ZeroValue;
+	TArray<float> Integration;
+	TArray<uint8> Direction;  // Index into the 8-neighbour table, NoDirection if unreachable
+};
+
+/**
+ * Shared flow-field navigation for AI tanks.
+ * One field per goal block (GoalSnapCells cells square) is computed on a background task and
+ * reused by every bot, so per-bot cost is a single cell lookup and a goal drifting within its
+ * block reuses the field. Obstacle changes from destruction trigger an incremental
+ * re-integration of the existing fields in the background.
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Desired world-space move direction toward Goal (false until the field for Goal is ready,
+	// and inside the goal's own block - steer straight at the goal there)
+	bool GetFlowDirection(const FVector& Goal, const FVector& From, FVector& OutDirection);
+
+	// Destruction changed what blocks movement - fields are repaired on the next rebuild
+	void NotifyObstaclesChanged() { bObstaclesDirty = true; }
+
+	const FFlowFieldGrid* GetGrid() const { return Grid.Get(); }
+
+protected:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FBuildResult
+	{
+		TSharedPtr<const FFlowFieldGrid> Grid;
+		TArray<TSharedPtr<const FFlowField>> Fields;
+	};
+
+	void StartBuild();
+	void GatherObstacles(TArray<FBox>& OutBoxes) const;
+
+	// Background work - pure functions of their inputs
+	static TSharedPtr<FFlowFieldGrid> RasterizeGrid(const FFlowFieldGrid& Layout, const TArray<FBox>& Obstacles);
+	static TSharedPtr<FFlowField> ComputeField(const FFlowFieldGrid& Layout, const FIntPoint& Goal, int32 GoalSnap);
+	static TSharedPtr<FFlowField> RepairField(const FFlowFieldGrid& OldGrid, const FFlowFieldGrid& NewGrid, const FFlowField& OldField);
+	static void SeedGoal(const FFlowFieldGrid& Layout, FFlowField& Field, TArray<TPair<float, int32>>& Heap);
+	static void Integrate(const FFlowFieldGrid& Layout, FFlowField& Field, TArray<TPair<float, int32>>& Heap);
+	static void ComputeDirections(const FFlowFieldGrid& Layout, FFlowField& Field);
+
+	// === CONFIG (DefaultGame.ini) ===
+	UPROPERTY(Config)
+	float CellSize = 200.f;
+
+	// Cells per side, grid is centered on the world origin
+	UPROPERTY(Config)
+	int32 GridCells = 256;
+
+	// Obstacles are inflated by this much so hulls don't clip corners
+	UPROPERTY(Config)
+	float ObstaclePadding = 150.f;
+
+	// Minimum time between background rebuilds
+	UPROPERTY(Config)
+	float RebuildInterval = 0.5f;
+
+	UPROPERTY(Config)
+	int32 MaxFields = 8;
+
+	// Goals are grouped into blocks this many cells square; one field serves the whole block
+	UPROPERTY(Config)
+	int32 GoalSnapCells = 4;
+
+	TSharedPtr<const FFlowFieldGrid> Grid;
+
+	// Tagged level geometry, gathered once at begin play: static bounds are kept,
+	// movable actors are re-read on each rebuild
+	TArray<FBox> StaticObstacles;
+	TArray<TWeakObjectPtr<AActor>> MovableObstacles;
+
+	TMap<FIntPoint, TSharedPtr<const FFlowField>> Fields;
+	TMap<FIntPoint, double> FieldLastUsed;
+	TSet<FIntPoint> RequestedGoals;
+
+	UE::Tasks::TTask<FBuildResult> BuildTask;
+	bool bBuildInFlight = false;
+	bool bObstaclesDirty = true;
+	double LastBuildTime = -1.0;
+};
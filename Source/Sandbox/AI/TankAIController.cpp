@@ -0,0 +1,129 @@
+#include "TankAIController.h"
+#include "FlowFieldSubsystem.h"
+#include "Pawns/TankPawn.h"
+#include "Components/TankBodyComponent.h"
+#include "Systems/AimSolverSubsystem.h"
+#include "EngineUtils.h"
+#include "Kismet/GameplayStatics.h"
+
+ATankAIController::ATankAIController()
+{
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void ATankAIController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+	FlowFields = GetWorld()->GetSubsystem<UFlowFieldSubsystem>();
+	AimSolver = GetWorld()->GetSubsystem<UAimSolverSubsystem>();
+}
+
+void ATankAIController::SetGoalLocation(const FVector& Location)
+{
+	GoalLocation = Location;
+	bHasGoal = true;
+}
+
+bool ATankAIController::GetGoal(FVector& OutGoal) const
+{
+	if (bHasGoal)
+	{
+		OutGoal = GoalLocation;
+		return true;
+	}
+
+	if (APawn* Player = UGameplayStatics::GetPlayerPawn(this, 0))
+	{
+		OutGoal = Player->GetActorLocation();
+		return true;
+	}
+	return false;
+}
+
+void ATankAIController::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	ATankPawn* Tank = Cast<ATankPawn>(GetPawn());
+	if (!Tank) return;
+
+	UpdateGunner(Tank, DeltaTime);
+
+	FVector Goal;
+	const FVector Location = Tank->GetActorLocation();
+	if (!GetGoal(Goal) || FVector::Dist2D(Location, Goal) < ArriveDistance)
+	{
+		Tank->SetDriveInput(0.f, 0.f);
+		return;
+	}
+
+	// Shared field lookup; head straight for the goal until the field is ready
+	FVector Desired;
+	if (!FlowFields || !FlowFields->GetFlowDirection(Goal, Location, Desired))
+	{
+		Desired = (Goal - Location).GetSafeNormal2D();
+	}
+
+	const FVector Forward = Tank->GetActorForwardVector().GetSafeNormal2D();
+	const float HeadingError = FMath::RadiansToDegrees(FMath::Atan2(
+		FVector::CrossProduct(Forward, Desired).Z, FVector::DotProduct(Forward, Desired)));
+
+	// Turn toward the flow, ease off the throttle for sharp corners and pivot when facing away
+	const float Turn = FMath::Clamp(HeadingError / FullTurnAngle, -1.f, 1.f);
+	const float Throttle = FMath::Clamp(FMath::Cos(FMath::DegreesToRadians(HeadingError)), 0.f, 1.f);
+
+	Tank->SetDriveInput(Throttle, Turn);
+}
+
+ATankPawn* ATankAIController::FindTarget(const ATankPawn* Tank) const
+{
+	ATankPawn* Nearest = nullptr;
+	float NearestSq = FMath::Square(EngageRange);
+	for (TActorIterator<ATankPawn> It(GetWorld()); It; ++It)
+	{
+		if (*It == Tank) continue;
+
+		const float DistSq = FVector::DistSquared(It->GetActorLocation(), Tank->GetActorLocation());
+		if (DistSq < NearestSq)
+		{
+			NearestSq = DistSq;
+			Nearest = *It;
+		}
+	}
+	return Nearest;
+}
+
+void ATankAIController::UpdateGunner(ATankPawn* Tank, float DeltaTime)
+{
+	RetargetTimer -= DeltaTime;
+	if (RetargetTimer <= 0.f || !Target.IsValid())
+	{
+		RetargetTimer = RetargetInterval;
+		Target = FindTarget(Tank);
+	}
+
+	ATankPawn* CurrentTarget = Target.Get();
+	if (!AimSolver || !CurrentTarget || !Tank->GetTankBody())
+	{
+		// Nothing to shoot at - turret follows the hull
+		Tank->SetAim(Tank->GetActorRotation().Yaw, 0.f);
+		return;
+	}
+
+	// Solved in last frame's batch; fire once the arc is known to be clear
+	FAimSolution Solution;
+	if (AimSolver->GetSolution(Tank, Solution) && Solution.bInRange)
+	{
+		// Solution pitch is barrel elevation - it goes through SetAim to SetTurretAim unchanged,
+		// but a shot is only worth taking if the barrel can actually reach it
+		Tank->SetAim(Solution.Yaw, Solution.Pitch);
+		const bool bReachable = Solution.Pitch >= 0.f && Solution.Pitch <= UTankBodyComponent::MaxBarrelPitch;
+		if (bReachable && Solution.bClear && Tank->CanFire())
+		{
+			Tank->TryFire();
+		}
+	}
+
+	AimSolver->RequestAim(Tank, Tank->GetTankBody()->GetMuzzleLocation(),
+		CurrentTarget->GetActorLocation(), CurrentTarget->GetVelocity());
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "TankAIController.generated.h"
+
+class UFlowFieldSubsystem;
+class UAimSolverSubsystem;
+class ATankPawn;
+
+/**
+ * Bot tank driver - steers along the shared flow field toward its goal and feeds
+ * throttle/turn into ATankPawn's normal ApplyMovement path.
+ * Without an explicit goal it chases the first player's tank.
+ * The gunner engages the nearest other tank in range using UAimSolverSubsystem.
+ */
+UCLASS()
+class SANDBOX_API ATankAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	ATankAIController();
+
+	virtual void Tick(float DeltaTime) override;
+
+	void SetGoalLocation(const FVector& Location);
+	void ClearGoal() { bHasGoal = false; }
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+
+	bool GetGoal(FVector& OutGoal) const;
+
+	// Aim at (and fire on) the current target from the last batched solution, queue the next request
+	void UpdateGunner(ATankPawn* Tank, float DeltaTime);
+	ATankPawn* FindTarget(const ATankPawn* Tank) const;
+
+	// Stop within this distance of the goal
+	UPROPERTY(EditAnywhere, Category = "Tank|AI")
+	float ArriveDistance = 800.f;
+
+	// Heading error that gives full turn input
+	UPROPERTY(EditAnywhere, Category = "Tank|AI")
+	float FullTurnAngle = 45.f;
+
+	// Targets further than this are ignored
+	UPROPERTY(EditAnywhere, Category = "Tank|AI")
+	float EngageRange = 15000.f;
+
+	// Seconds between nearest-target searches
+	UPROPERTY(EditAnywhere, Category = "Tank|AI")
+	float RetargetInterval = 1.f;
+
+	UPROPERTY()
+	UFlowFieldSubsystem* FlowFields;
+
+	UPROPERTY()
+	UAimSolverSubsystem* AimSolver;
+
+	TWeakObjectPtr<ATankPawn> Target;
+	float RetargetTimer = 0.f;
+
+	FVector GoalLocation = FVector::ZeroVector;
+	bool bHasGoal = false;
+};
@@ -1,7 +1,9 @@
 #include "TankBodyComponent.h"
+#include "Sandbox.h"
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "UObject/ConstructorHelpers.h"
+#include "Systems/TankVisualsSubsystem.h"
 
 UTankBodyComponent::UTankBodyComponent()
 {
@@ -12,21 +14,15 @@ UTankBodyComponent::UTankBodyComponent()
 	UStaticMesh* Cube = CubeMesh.Object;
 	UStaticMesh* Cylinder = CylinderMesh.Object;
 
-	if (BaseMat.Object)
-	{
-		HullMat = UMaterialInstanceDynamic::Create(BaseMat.Object, this);
-		HullMat->SetVectorParameterValue(TEXT("Color"), FLinearColor(0.28f, 0.35f, 0.22f));
-
-		TreadMat = UMaterialInstanceDynamic::Create(BaseMat.Object, this);
-		TreadMat->SetVectorParameterValue(TEXT("Color"), FLinearColor(0.12f, 0.12f, 0.12f));
-
-		BarrelMat = UMaterialInstanceDynamic::Create(BaseMat.Object, this);
-		BarrelMat->SetVectorParameterValue(TEXT("Color"), FLinearColor(0.15f, 0.15f, 0.12f));
-	}
+	// Treads and material instances are made at initialization (registration in the editor),
+	// so the CDO and every instance have the same default subobjects whether or not this
+	// process renders
+	bWantsInitializeComponent = true;
+	TreadMesh = Cube;
+	BaseMaterial = BaseMat.Object;
 
-	auto SetupMesh = [](UStaticMeshComponent* M, UStaticMesh* SM, UMaterialInstanceDynamic* Mat) {
+	auto SetupMesh = [](UStaticMeshComponent* M, UStaticMesh* SM) {
 		if (SM) M->SetStaticMesh(SM);
-		if (Mat) M->SetMaterial(0, Mat);
 		M->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 		M->SetCastShadow(true);
 	};
@@ -34,14 +30,10 @@ UTankBodyComponent::UTankBodyComponent()
 	// === HULL ===
 	Hull = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Hull"));
 	Hull->SetupAttachment(this);
-	SetupMesh(Hull, Cube, HullMat);
+	SetupMesh(Hull, Cube);
 	Hull->SetRelativeScale3D(FVector(2.4f, 1.4f, 0.5f));
 	Hull->SetRelativeLocation(FVector(0.f, 0.f, 20.f));
 
-	// === TREAD SEGMENTS ===
-	CreateTreadSegments(true, Cube);
-	CreateTreadSegments(false, Cube);
-
 	// === TURRET (attached to hull, rotates with it, but yaw controlled separately) ===
 	TurretPivot = CreateDefaultSubobject<USceneComponent>(TEXT("TurretPivot"));
 	TurretPivot->SetupAttachment(this);
@@ -50,7 +42,7 @@ UTankBodyComponent::UTankBodyComponent()
 
 	Turret = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Turret"));
 	Turret->SetupAttachment(TurretPivot);
-	SetupMesh(Turret, Cube, HullMat);
+	SetupMesh(Turret, Cube);
 	Turret->SetRelativeScale3D(FVector(1.0f, 0.85f, 0.4f));
 	Turret->SetRelativeLocation(FVector(0.f, 0.f, 20.f));
 
@@ -61,72 +53,166 @@ UTankBodyComponent::UTankBodyComponent()
 
 	Barrel = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Barrel"));
 	Barrel->SetupAttachment(BarrelPivot);
-	SetupMesh(Barrel, Cylinder, BarrelMat);
+	SetupMesh(Barrel, Cylinder);
 	Barrel->SetRelativeScale3D(FVector(0.12f, 0.12f, 0.9f));
 	Barrel->SetRelativeLocation(FVector(45.f, 0.f, 0.f));
 	Barrel->SetRelativeRotation(FRotator(90.f, 0.f, 0.f));
 }
 
-void UTankBodyComponent::CreateTreadSegments(bool bLeftSide, UStaticMesh* Cube)
+void UTankBodyComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// Editor preview only. Game worlds wait for InitializeComponent: SpawnActorDeferred already
+	// registers components, and the treads should cost FinishSpawning, not construction.
+	// Re-registration (editor property changes) finds the treads already there.
+	const UWorld* World = GetWorld();
+	if (World && !World->IsGameWorld() && LeftTreads.Num() == 0 && !Sandbox::IsCosmeticDisabled())
+	{
+		CreateCosmetics();
+	}
+}
+
+void UTankBodyComponent::InitializeComponent()
 {
+	Super::InitializeComponent();
+
+	// Server keeps the hull/turret/barrel hierarchy for muzzle placement, nothing else
+	if (LeftTreads.Num() == 0 && !Sandbox::IsCosmeticDisabled())
+	{
+		CreateCosmetics();
+	}
+}
+
+void UTankBodyComponent::CreateCosmetics()
+{
+	if (BaseMaterial)
+	{
+		HullMat = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+		HullMat->SetVectorParameterValue(TEXT("Color"), FLinearColor(0.28f, 0.35f, 0.22f));
+
+		TreadMat = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+		TreadMat->SetVectorParameterValue(TEXT("Color"), FLinearColor(0.12f, 0.12f, 0.12f));
+
+		BarrelMat = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+		BarrelMat->SetVectorParameterValue(TEXT("Color"), FLinearColor(0.15f, 0.15f, 0.12f));
+
+		Hull->SetMaterial(0, HullMat);
+		Turret->SetMaterial(0, HullMat);
+		Barrel->SetMaterial(0, BarrelMat);
+	}
+
+	// 32 components per tank nobody on a server would see
+	CreateTreadSegments(true);
+	CreateTreadSegments(false);
+}
+
+void UTankBodyComponent::CreateTreadSegments(bool bLeftSide)
+{
+	// Names and rest positions are the same for every tank - build them once rather than per instance
+	struct FTreadLayout
+	{
+		FName Names[2][TreadSegments];
+		FVector Positions[2][TreadSegments];
+	};
+	static const FTreadLayout Layout = []
+	{
+		FTreadLayout L;
+		for (int32 Side = 0; Side < 2; Side++)
+		{
+			for (int32 i = 0; i < TreadSegments; i++)
+			{
+				L.Names[Side][i] = FName(*FString::Printf(TEXT("Tread_%s_%d"), Side == 0 ? TEXT("L") : TEXT("R"), i));
+				L.Positions[Side][i] = ComputeTreadPosition(0.f, i, TreadSegments, Side == 0);
+			}
+		}
+		return L;
+	}();
+
 	TArray<UStaticMeshComponent*>& Treads = bLeftSide ? LeftTreads : RightTreads;
-	FString Side = bLeftSide ? TEXT("L") : TEXT("R");
+	const int32 Side = bLeftSide ? 0 : 1;
+	Treads.Reserve(TreadSegments);
 
 	for (int32 i = 0; i < TreadSegments; i++)
 	{
-		FName Name(*FString::Printf(TEXT("Tread_%s_%d"), *Side, i));
-		UStaticMeshComponent* Seg = CreateDefaultSubobject<UStaticMeshComponent>(Name);
+		UStaticMeshComponent* Seg = NewObject<UStaticMeshComponent>(GetOwner(), Layout.Names[Side][i], RF_Transient);
 		Seg->SetupAttachment(this);
-		if (Cube) Seg->SetStaticMesh(Cube);
+		if (TreadMesh) Seg->SetStaticMesh(TreadMesh);
 		if (TreadMat) Seg->SetMaterial(0, TreadMat);
 		Seg->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 		Seg->SetRelativeScale3D(FVector(0.22f, 0.28f, 0.1f));
+		Seg->SetRelativeLocation_Direct(Layout.Positions[Side][i]);
+		Seg->RegisterComponent();
 		Treads.Add(Seg);
 	}
+}
 
-	UpdateTreadPositions(bLeftSide);
+void UTankBodyComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UTankVisualsSubsystem* Visuals = GetWorld()->GetSubsystem<UTankVisualsSubsystem>())
+	{
+		Visuals->Register(this);
+		bBatchedVisuals = true;
+	}
 }
 
-void UTankBodyComponent::UpdateTreadPositions(bool bLeftSide)
+void UTankBodyComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bBatchedVisuals)
+	{
+		if (UTankVisualsSubsystem* Visuals = GetWorld()->GetSubsystem<UTankVisualsSubsystem>())
+		{
+			Visuals->Unregister(this);
+		}
+		bBatchedVisuals = false;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FVector UTankBodyComponent::ComputeTreadPosition(float Offset, int32 Index, int32 Num, bool bLeftSide)
 {
-	TArray<UStaticMeshComponent*>& Treads = bLeftSide ? LeftTreads : RightTreads;
-	float Offset = bLeftSide ? LeftTreadOffset : RightTreadOffset;
 	float Y = bLeftSide ? -TreadY : TreadY;
 
 	float HalfLen = TreadLength * 0.5f;
 	float Height = TreadTopZ - TreadBottomZ;
 	float Perimeter = TreadLength * 2.f + Height * 2.f;
 
-	for (int32 i = 0; i < Treads.Num(); i++)
+	float T = FMath::Fmod(Offset + (float)Index / Num, 1.f);
+	if (T < 0.f) T += 1.f;
+	float Dist = T * Perimeter;
+
+	if (Dist < TreadLength)
+	{
+		return FVector(-HalfLen + Dist, Y, TreadTopZ);
+	}
+	else if (Dist < TreadLength + Height)
 	{
-		float T = FMath::Fmod(Offset + (float)i / Treads.Num(), 1.f);
-		if (T < 0.f) T += 1.f;
-		float Dist = T * Perimeter;
+		float D = Dist - TreadLength;
+		float Alpha = D / Height;
+		return FVector(HalfLen, Y, FMath::Lerp(TreadTopZ, TreadBottomZ, Alpha));
+	}
+	else if (Dist < TreadLength * 2.f + Height)
+	{
+		float D = Dist - TreadLength - Height;
+		return FVector(HalfLen - D, Y, TreadBottomZ);
+	}
 
-		FVector Pos;
-		if (Dist < TreadLength)
-		{
-			Pos = FVector(-HalfLen + Dist, Y, TreadTopZ);
-		}
-		else if (Dist < TreadLength + Height)
-		{
-			float D = Dist - TreadLength;
-			float Alpha = D / Height;
-			Pos = FVector(HalfLen, Y, FMath::Lerp(TreadTopZ, TreadBottomZ, Alpha));
-		}
-		else if (Dist < TreadLength * 2.f + Height)
-		{
-			float D = Dist - TreadLength - Height;
-			Pos = FVector(HalfLen - D, Y, TreadBottomZ);
-		}
-		else
-		{
-			float D = Dist - TreadLength * 2.f - Height;
-			float Alpha = D / Height;
-			Pos = FVector(-HalfLen, Y, FMath::Lerp(TreadBottomZ, TreadTopZ, Alpha));
-		}
+	float D = Dist - TreadLength * 2.f - Height;
+	float Alpha = D / Height;
+	return FVector(-HalfLen, Y, FMath::Lerp(TreadBottomZ, TreadTopZ, Alpha));
+}
 
-		Treads[i]->SetRelativeLocation(Pos);
+void UTankBodyComponent::UpdateTreadPositions(bool bLeftSide)
+{
+	TArray<UStaticMeshComponent*>& Treads = bLeftSide ? LeftTreads : RightTreads;
+	float Offset = bLeftSide ? LeftTreadOffset : RightTreadOffset;
+
+	for (int32 i = 0; i < Treads.Num(); i++)
+	{
+		Treads[i]->SetRelativeLocation(ComputeTreadPosition(Offset, i, Treads.Num(), bLeftSide));
 		Treads[i]->SetRelativeRotation(FRotator::ZeroRotator);
 	}
 }
@@ -134,7 +220,10 @@ void UTankBodyComponent::UpdateTreadPositions(bool bLeftSide)
 void UTankBodyComponent::SetTurretAim(float WorldYaw, float Pitch)
 {
 	AimYaw = WorldYaw;
-	AimPitch = FMath::Clamp(Pitch, 0.f, 50.f);
+	AimPitch = FMath::Clamp(Pitch, 0.f, MaxBarrelPitch);
+
+	// Batched - pivots are rotated by UTankVisualsSubsystem
+	if (bBatchedVisuals) return;
 
 	if (TurretPivot)
 	{
@@ -153,20 +242,88 @@ void UTankBodyComponent::SetTurretAim(float WorldYaw, float Pitch)
 
 void UTankBodyComponent::UpdateTreads(float ForwardSpeed, float TurnRate)
 {
-	float TargetLeftSpeed = ForwardSpeed + TurnRate;
-	float TargetRightSpeed = ForwardSpeed - TurnRate;
+	TargetLeftSpeed = ForwardSpeed + TurnRate;
+	TargetRightSpeed = ForwardSpeed - TurnRate;
+
+	// Batched - animation is advanced by UTankVisualsSubsystem. No treads - nothing to animate.
+	if (bBatchedVisuals || (LeftTreads.Num() == 0 && RightTreads.Num() == 0)) return;
 	
-	SmoothedLeftSpeed = FMath::FInterpTo(SmoothedLeftSpeed, TargetLeftSpeed, GetWorld()->GetDeltaSeconds(), 8.f);
-	SmoothedRightSpeed = FMath::FInterpTo(SmoothedRightSpeed, TargetRightSpeed, GetWorld()->GetDeltaSeconds(), 8.f);
+	SmoothedLeftSpeed = FMath::FInterpTo(SmoothedLeftSpeed, TargetLeftSpeed, GetWorld()->GetDeltaSeconds(), TreadInterpSpeed);
+	SmoothedRightSpeed = FMath::FInterpTo(SmoothedRightSpeed, TargetRightSpeed, GetWorld()->GetDeltaSeconds(), TreadInterpSpeed);
 	
-	float Rate = 0.0002f;
-	LeftTreadOffset = FMath::Fmod(LeftTreadOffset + SmoothedLeftSpeed * Rate + 1.f, 1.f);
-	RightTreadOffset = FMath::Fmod(RightTreadOffset + SmoothedRightSpeed * Rate + 1.f, 1.f);
+	LeftTreadOffset = FMath::Fmod(LeftTreadOffset + SmoothedLeftSpeed * TreadRate + 1.f, 1.f);
+	RightTreadOffset = FMath::Fmod(RightTreadOffset + SmoothedRightSpeed * TreadRate + 1.f, 1.f);
 
 	UpdateTreadPositions(true);
 	UpdateTreadPositions(false);
 }
 
+void UTankBodyComponent::GatherVisualJob(FTankVisualJob& Job) const
+{
+	Job.TargetLeftSpeed = TargetLeftSpeed;
+	Job.TargetRightSpeed = TargetRightSpeed;
+	Job.HullYaw = GetComponentRotation().Yaw;
+	Job.AimYaw = AimYaw;
+	Job.AimPitch = AimPitch;
+	Job.LeftOffset = LeftTreadOffset;
+	Job.RightOffset = RightTreadOffset;
+	Job.SmoothedLeftSpeed = SmoothedLeftSpeed;
+	Job.SmoothedRightSpeed = SmoothedRightSpeed;
+}
+
+void UTankBodyComponent::ComputeVisualJob(FTankVisualJob& Job, float DeltaTime)
+{
+	Job.TurretRotation = FRotator(0.f, Job.AimYaw - Job.HullYaw, 0.f);
+	Job.BarrelRotation = FRotator(-Job.AimPitch, 0.f, 0.f);
+
+	if (!Job.bAnimateTreads) return;
+
+	Job.SmoothedLeftSpeed = FMath::FInterpTo(Job.SmoothedLeftSpeed, Job.TargetLeftSpeed, DeltaTime, TreadInterpSpeed);
+	Job.SmoothedRightSpeed = FMath::FInterpTo(Job.SmoothedRightSpeed, Job.TargetRightSpeed, DeltaTime, TreadInterpSpeed);
+
+	Job.LeftOffset = FMath::Fmod(Job.LeftOffset + Job.SmoothedLeftSpeed * TreadRate + 1.f, 1.f);
+	Job.RightOffset = FMath::Fmod(Job.RightOffset + Job.SmoothedRightSpeed * TreadRate + 1.f, 1.f);
+
+	for (int32 i = 0; i < FTankVisualJob::NumSegments; i++)
+	{
+		Job.LeftPositions[i] = ComputeTreadPosition(Job.LeftOffset, i, FTankVisualJob::NumSegments, true);
+		Job.RightPositions[i] = ComputeTreadPosition(Job.RightOffset, i, FTankVisualJob::NumSegments, false);
+	}
+}
+
+void UTankBodyComponent::ApplyVisualJob(const FTankVisualJob& Job)
+{
+	LeftTreadOffset = Job.LeftOffset;
+	RightTreadOffset = Job.RightOffset;
+	SmoothedLeftSpeed = Job.SmoothedLeftSpeed;
+	SmoothedRightSpeed = Job.SmoothedRightSpeed;
+
+	// Segments have no collision or children - write the transform directly and skip MoveComponent
+	auto ApplySide = [](TArray<UStaticMeshComponent*>& Treads, const FVector* Positions)
+	{
+		for (int32 i = 0; i < Treads.Num() && i < FTankVisualJob::NumSegments; i++)
+		{
+			Treads[i]->SetRelativeLocation_Direct(Positions[i]);
+			Treads[i]->UpdateComponentToWorld(EUpdateTransformFlags::SkipPhysicsUpdate);
+		}
+	};
+	if (Job.bAnimateTreads)
+	{
+		ApplySide(LeftTreads, Job.LeftPositions);
+		ApplySide(RightTreads, Job.RightPositions);
+	}
+
+	if (TurretPivot)
+	{
+		TurretPivot->SetRelativeRotation(Job.TurretRotation);
+	}
+
+	if (BarrelPivot)
+	{
+		BarrelPivot->SetRelativeRotation(Job.BarrelRotation);
+	}
+}
+
 FVector UTankBodyComponent::GetMuzzleLocation() const
 {
 	if (Barrel)
@@ -5,8 +5,38 @@
 #include "TankBodyComponent.generated.h"
 
 class UStaticMeshComponent;
+class UMaterialInterface;
 class UMaterialInstanceDynamic;
 
+/**
+ * Per-tank visual update job - pure data so UTankVisualsSubsystem can compute
+ * all tanks on worker threads and apply the results in one game-thread pass.
+ */
+struct FTankVisualJob
+{
+	static constexpr int32 NumSegments = 16;
+
+	// Inputs
+	float TargetLeftSpeed = 0.f;
+	float TargetRightSpeed = 0.f;
+	float HullYaw = 0.f;
+	float AimYaw = 0.f;
+	float AimPitch = 0.f;
+	bool bAnimateTreads = true;  // False when far from every view - treads hold still
+
+	// Animation state (in/out)
+	float LeftOffset = 0.f;
+	float RightOffset = 0.f;
+	float SmoothedLeftSpeed = 0.f;
+	float SmoothedRightSpeed = 0.f;
+
+	// Outputs (relative to the body component)
+	FVector LeftPositions[NumSegments];
+	FVector RightPositions[NumSegments];
+	FRotator TurretRotation = FRotator::ZeroRotator;
+	FRotator BarrelRotation = FRotator::ZeroRotator;
+};
+
 /**
  * Visual tank assembly - hull, turret, barrel, animated treads.
  * 
@@ -21,7 +51,11 @@ class SANDBOX_API UTankBodyComponent : public USceneComponent
 public:
 	UTankBodyComponent();
 
-	// Set turret aim - yaw is world-space, pitch is elevation (0-50 degrees up)
+	// Barrel elevation range, degrees up
+	static constexpr float MaxBarrelPitch = 50.f;
+
+	// Set turret aim - yaw is world-space, pitch is elevation (0 to MaxBarrelPitch degrees up)
+	// When batched, only the targets are stored; UTankVisualsSubsystem applies them later this frame
 	void SetTurretAim(float WorldYaw, float Pitch);
 	
 	void UpdateTreads(float ForwardSpeed, float TurnRate);
@@ -29,9 +63,24 @@ public:
 	FVector GetMuzzleLocation() const;
 	FVector GetMuzzleDirection() const;
 
+	// === BATCHED UPDATE (UTankVisualsSubsystem) ===
+	void GatherVisualJob(FTankVisualJob& Job) const;
+	void ApplyVisualJob(const FTankVisualJob& Job);
+
+	// Pure math - safe to call from worker threads
+	static void ComputeVisualJob(FTankVisualJob& Job, float DeltaTime);
+
+protected:
+	virtual void OnRegister() override;
+	virtual void InitializeComponent() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 private:
-	void CreateTreadSegments(bool bLeftSide, UStaticMesh* Mesh);
+	void CreateCosmetics();
+	void CreateTreadSegments(bool bLeftSide);
 	void UpdateTreadPositions(bool bLeftSide);
+	static FVector ComputeTreadPosition(float Offset, int32 Index, int32 Num, bool bLeftSide);
 
 	// Hull
 	UPROPERTY(VisibleAnywhere)
@@ -51,24 +100,30 @@ private:
 	UPROPERTY(VisibleAnywhere)
 	UStaticMeshComponent* Barrel;
 
-	// Treads
-	static constexpr int32 TreadSegments = 16;
+	// Treads - created at registration, never on a server
+	static constexpr int32 TreadSegments = FTankVisualJob::NumSegments;
 	
-	UPROPERTY()
+	UPROPERTY(Transient)
 	TArray<UStaticMeshComponent*> LeftTreads;
 	
-	UPROPERTY()
+	UPROPERTY(Transient)
 	TArray<UStaticMeshComponent*> RightTreads;
 
-	// Materials
 	UPROPERTY()
-	UMaterialInstanceDynamic* HullMat;
+	UStaticMesh* TreadMesh = nullptr;
 
+	// Materials - instanced at registration, never on a server
 	UPROPERTY()
-	UMaterialInstanceDynamic* TreadMat;
+	UMaterialInterface* BaseMaterial = nullptr;
 
-	UPROPERTY()
-	UMaterialInstanceDynamic* BarrelMat;
+	UPROPERTY(Transient)
+	UMaterialInstanceDynamic* HullMat = nullptr;
+
+	UPROPERTY(Transient)
+	UMaterialInstanceDynamic* TreadMat = nullptr;
+
+	UPROPERTY(Transient)
+	UMaterialInstanceDynamic* BarrelMat = nullptr;
 
 	// Tread animation state
 	float LeftTreadOffset = 0.f;
@@ -76,11 +131,20 @@ private:
 	float SmoothedLeftSpeed = 0.f;
 	float SmoothedRightSpeed = 0.f;
 
+	// Tread targets, consumed by the batched update
+	float TargetLeftSpeed = 0.f;
+	float TargetRightSpeed = 0.f;
+
+	// Registered with UTankVisualsSubsystem (updates deferred to its tick)
+	bool bBatchedVisuals = false;
+
 	// Tread geometry
-	const float TreadLength = 280.f;
-	const float TreadY = 90.f;
-	const float TreadTopZ = 15.f;
-	const float TreadBottomZ = -15.f;
+	static constexpr float TreadLength = 280.f;
+	static constexpr float TreadY = 90.f;
+	static constexpr float TreadTopZ = 15.f;
+	static constexpr float TreadBottomZ = -15.f;
+	static constexpr float TreadRate = 0.0002f;
+	static constexpr float TreadInterpSpeed = 8.f;
 
 	// Aim state (for muzzle direction calculation)
 	float AimYaw = 0.f;
@@ -0,0 +1,192 @@
+#include "TankSuspensionComponent.h"
+#include "Pawns/TankPawn.h"
+#include "Systems/TankSuspensionSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+
+UTankSuspensionComponent::UTankSuspensionComponent()
+{
+	// Driven by UTankSuspensionSubsystem, not per-component ticks
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UTankSuspensionComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Body = Cast<UPrimitiveComponent>(GetOwner()->GetRootComponent());
+	QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(TankSuspension), false, GetOwner());
+	BuildWheels();
+
+	if (UTankSuspensionSubsystem* Subsystem = GetWorld()->GetSubsystem<UTankSuspensionSubsystem>())
+	{
+		Subsystem->Register(this);
+	}
+}
+
+void UTankSuspensionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UTankSuspensionSubsystem* Subsystem = GetWorld()->GetSubsystem<UTankSuspensionSubsystem>())
+	{
+		Subsystem->Unregister(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTankSuspensionComponent::BuildWheels()
+{
+	Wheels.Reset();
+	const int32 Count = FMath::Max(2, WheelsPerSide);
+
+	for (int32 Side = 0; Side < 2; Side++)
+	{
+		for (int32 i = 0; i < Count; i++)
+		{
+			FWheel& Wheel = Wheels.AddDefaulted_GetRef();
+			Wheel.bLeft = Side == 0;
+			Wheel.LocalMount = FVector(
+				FMath::Lerp(-TrackLength * 0.5f, TrackLength * 0.5f, (float)i / (Count - 1)),
+				Wheel.bLeft ? -TrackHalfWidth : TrackHalfWidth,
+				MountZ);
+		}
+	}
+}
+
+void UTankSuspensionComponent::IssueTraces(UWorld* World)
+{
+	if (!Body) return;
+
+	const FTransform Transform = Body->GetComponentTransform();
+	const FVector Down = -Transform.GetUnitAxis(EAxis::Z);
+	const FCollisionShape Sphere = FCollisionShape::MakeSphere(WheelRadius);
+
+	for (FWheel& Wheel : Wheels)
+	{
+		const FVector Start = Transform.TransformPosition(Wheel.LocalMount);
+		Wheel.Trace = World->AsyncSweepByChannel(EAsyncTraceType::Single, Start, Start + Down * RestLength,
+			FQuat::Identity, ECC_Visibility, Sphere, QueryParams);
+	}
+}
+
+void UTankSuspensionComponent::ConsumeTraces(UWorld* World, float DeltaTime)
+{
+	NumGrounded = 0;
+	LeftTrackSpeed = 0.f;
+	RightTrackSpeed = 0.f;
+	if (!Body || !Body->IsSimulatingPhysics() || DeltaTime <= 0.f) return;
+
+	// Collect last frame's batch first so drive and traction can be split over grounded wheels
+	TArray<FHitResult, TInlineAllocator<16>> Hits;
+	Hits.SetNum(Wheels.Num());
+
+	FTraceDatum Datum;
+	for (int32 i = 0; i < Wheels.Num(); i++)
+	{
+		FWheel& Wheel = Wheels[i];
+		Wheel.bGrounded = false;
+
+		if (!Wheel.Trace.IsValid() || !World->QueryTraceData(Wheel.Trace, Datum)) continue;
+
+		for (const FHitResult& Hit : Datum.OutHits)
+		{
+			if (Hit.bBlockingHit)
+			{
+				Hits[i] = Hit;
+				Wheel.bGrounded = true;
+				NumGrounded++;
+				break;
+			}
+		}
+	}
+
+	if (NumGrounded == 0)
+	{
+		for (FWheel& Wheel : Wheels)
+		{
+			Wheel.Compression = 0.f;
+		}
+		return;
+	}
+
+	const FTransform Transform = Body->GetComponentTransform();
+	const FVector Up = Transform.GetUnitAxis(EAxis::Z);
+	const FVector Forward = Transform.GetUnitAxis(EAxis::X);
+	const FVector Right = Transform.GetUnitAxis(EAxis::Y);
+	const FVector Velocity = Body->GetPhysicsLinearVelocity();
+	const float Mass = Body->GetMass();
+
+	const ATankPawn* Tank = Cast<ATankPawn>(GetOwner());
+	const float Throttle = Tank ? Tank->GetThrottleInput() : 0.f;
+	const float DriveForce = Tank ? Tank->GetDriveForce() : 0.f;
+	const float MaxSpeed = Tank ? Tank->GetMaxSpeed() : 0.f;
+
+	FVector Traction = FVector::ZeroVector;
+	FVector GroundNormal = FVector::ZeroVector;
+	int32 NumLeft = 0;
+	int32 NumRight = 0;
+
+	for (int32 i = 0; i < Wheels.Num(); i++)
+	{
+		FWheel& Wheel = Wheels[i];
+		if (!Wheel.bGrounded)
+		{
+			Wheel.Compression = 0.f;
+			continue;
+		}
+
+		const FHitResult& Hit = Hits[i];
+		const FVector WheelPos = Transform.TransformPosition(Wheel.LocalMount);
+
+		// Spring/damper along the hull's up axis, at the wheel
+		const float Compression = Hit.bStartPenetrating ? RestLength : FMath::Clamp(RestLength - Hit.Distance, 0.f, RestLength);
+		const float CompressionSpeed = (Compression - Wheel.Compression) / DeltaTime;
+		Wheel.Compression = Compression;
+
+		const float Spring = FMath::Max(0.f, Stiffness * Compression + Damping * CompressionSpeed);
+		Body->AddForceAtLocation(Up * Spring, WheelPos);
+
+		GroundNormal += Hit.ImpactNormal;
+
+		// Track speed from what the tread actually touches
+		const FVector GroundForward = FVector::VectorPlaneProject(Forward, Hit.ImpactNormal).GetSafeNormal();
+		const float RollSpeed = Body->GetPhysicsLinearVelocityAtPoint(WheelPos) | GroundForward;
+		if (Wheel.bLeft)
+		{
+			LeftTrackSpeed += RollSpeed;
+			NumLeft++;
+		}
+		else
+		{
+			RightTrackSpeed += RollSpeed;
+			NumRight++;
+		}
+	}
+
+	LeftTrackSpeed = NumLeft > 0 ? LeftTrackSpeed / NumLeft : 0.f;
+	RightTrackSpeed = NumRight > 0 ? RightTrackSpeed / NumRight : 0.f;
+
+	// Traction and drive scale with how much of the tread is on the ground.
+	// Applied at the center of mass so it doesn't fight skid-steer yaw.
+	const float ContactFraction = (float)NumGrounded / Wheels.Num();
+	GroundNormal = GroundNormal.GetSafeNormal();
+	const FVector GroundForward = FVector::VectorPlaneProject(Forward, GroundNormal).GetSafeNormal();
+	const FVector GroundRight = FVector::VectorPlaneProject(Right, GroundNormal).GetSafeNormal();
+
+	const float LateralSpeed = Velocity | GroundRight;
+	const float LongSpeed = Velocity | GroundForward;
+
+	Traction -= GroundRight * LateralSpeed * Mass * LateralGrip * ContactFraction;
+
+	if (FMath::Abs(Throttle) > 0.01f)
+	{
+		if (FMath::Abs(LongSpeed) < MaxSpeed || FMath::Sign(LongSpeed) != FMath::Sign(Throttle))
+		{
+			Traction += GroundForward * Throttle * DriveForce * ContactFraction;
+		}
+	}
+	else
+	{
+		Traction -= GroundForward * LongSpeed * Mass * BrakeGrip * ContactFraction;
+	}
+
+	Body->AddForce(Traction);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "TankSuspensionComponent.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ * Road-wheel suspension for the tank chassis.
+ * Each tread has WheelsPerSide sphere casts; UTankSuspensionSubsystem issues the casts
+ * for every tank as one async batch and hands the results back the next frame, where
+ * they become spring/damper, traction and drive forces.
+ */
+UCLASS()
+class SANDBOX_API UTankSuspensionComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTankSuspensionComponent();
+
+	// Called by UTankSuspensionSubsystem
+	void IssueTraces(UWorld* World);
+	void ConsumeTraces(UWorld* World, float DeltaTime);
+
+	int32 GetNumGroundedWheels() const { return NumGrounded; }
+
+	// Average ground speed along the hull at each tread's contacts (cm/s)
+	float GetLeftTrackSpeed() const { return LeftTrackSpeed; }
+	float GetRightTrackSpeed() const { return RightTrackSpeed; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	struct FWheel
+	{
+		FVector LocalMount = FVector::ZeroVector;
+		bool bLeft = false;
+		FTraceHandle Trace;
+		float Compression = 0.f;
+		bool bGrounded = false;
+	};
+
+	void BuildWheels();
+
+	UPROPERTY(EditAnywhere, Category = "Tank|Suspension")
+	int32 WheelsPerSide = 6;
+
+	// Distance between first and last wheel along a tread
+	UPROPERTY(EditAnywhere, Category = "Tank|Suspension")
+	float TrackLength = 520.f;
+
+	UPROPERTY(EditAnywhere, Category = "Tank|Suspension")
+	float TrackHalfWidth = 180.f;
+
+	// Wheel mount height in chassis space
+	UPROPERTY(EditAnywhere, Category = "Tank|Suspension")
+	float MountZ = -15.f;
+
+	UPROPERTY(EditAnywhere, Category = "Tank|Suspension")
+	float RestLength = 60.f;
+
+	UPROPERTY(EditAnywhere, Category = "Tank|Suspension")
+	float WheelRadius = 25.f;
+
+	// Spring force per cm of compression, per wheel
+	UPROPERTY(EditAnywhere, Category = "Tank|Suspension")
+	float Stiffness = 27000.f;
+
+	// Damper force per cm/s of compression speed, per wheel
+	UPROPERTY(EditAnywhere, Category = "Tank|Suspension")
+	float Damping = 6000.f;
+
+	// How fast sideways slip is removed (1/s)
+	UPROPERTY(EditAnywhere, Category = "Tank|Suspension")
+	float LateralGrip = 10.f;
+
+	// How fast rolling speed is removed with no throttle (1/s)
+	UPROPERTY(EditAnywhere, Category = "Tank|Suspension")
+	float BrakeGrip = 4.f;
+
+	UPROPERTY()
+	UPrimitiveComponent* Body;
+
+	TArray<FWheel> Wheels;
+	FCollisionQueryParams QueryParams;
+
+	int32 NumGrounded = 0;
+	float LeftTrackSpeed = 0.f;
+	float RightTrackSpeed = 0.f;
+};
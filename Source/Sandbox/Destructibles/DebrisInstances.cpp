@@ -0,0 +1,78 @@
+#include "DebrisInstances.h"
+#include "Sandbox.h"
+#include "DestructibleTarget.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+ADebrisInstances::ADebrisInstances()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+UInstancedStaticMeshComponent* ADebrisInstances::GetOrCreateComponent(TSubclassOf<ADestructibleTarget> Class)
+{
+	if (UInstancedStaticMeshComponent** Existing = Components.Find(Class))
+	{
+		return *Existing;
+	}
+
+	const ADestructibleTarget* CDO = Class->GetDefaultObject<ADestructibleTarget>();
+	UStaticMeshComponent* CDOMesh = CDO->GetMesh();
+	if (!CDOMesh || !CDOMesh->GetStaticMesh()) return nullptr;
+
+	UInstancedStaticMeshComponent* ISM = NewObject<UInstancedStaticMeshComponent>(this);
+	ISM->SetupAttachment(RootComponent);
+	ISM->SetStaticMesh(CDOMesh->GetStaticMesh());
+	ISM->SetCollisionProfileName(TEXT("DebrisSmall"));  // Final-depth rubble
+	ISM->SetGenerateOverlapEvents(false);
+
+	UMaterialInterface* BaseMat = CDOMesh->GetMaterial(0);
+	if (BaseMat && !Sandbox::IsCosmeticDisabled())
+	{
+		UMaterialInstanceDynamic* Mat = UMaterialInstanceDynamic::Create(BaseMat, this);
+		Mat->SetVectorParameterValue(TEXT("Color"), CDO->GetDebrisColor());
+		ISM->SetMaterial(0, Mat);
+	}
+
+	ISM->RegisterComponent();
+	Components.Add(Class, ISM);
+	return ISM;
+}
+
+void ADebrisInstances::AddPieces(TSubclassOf<ADestructibleTarget> Class, const TArray<FTransform>& Transforms)
+{
+	if (!Class || Transforms.Num() == 0) return;
+
+	UInstancedStaticMeshComponent* ISM = GetOrCreateComponent(Class);
+	if (!ISM) return;
+
+	ISM->AddInstances(Transforms, false, true);
+}
+
+void ADebrisInstances::ForEachPiece(TFunctionRef<void(TSubclassOf<ADestructibleTarget>, const FTransform&)> Func) const
+{
+	for (const TPair<TSubclassOf<ADestructibleTarget>, UInstancedStaticMeshComponent*>& Pair : Components)
+	{
+		const UInstancedStaticMeshComponent* ISM = Pair.Value;
+		if (!ISM) continue;
+
+		for (int32 i = 0; i < ISM->GetInstanceCount(); i++)
+		{
+			FTransform Transform;
+			ISM->GetInstanceTransform(i, Transform, true);
+			Func(Pair.Key, Transform);
+		}
+	}
+}
+
+int32 ADebrisInstances::GetNumPieces() const
+{
+	int32 Num = 0;
+	for (const TPair<TSubclassOf<ADestructibleTarget>, UInstancedStaticMeshComponent*>& Pair : Components)
+	{
+		Num += Pair.Value ? Pair.Value->GetInstanceCount() : 0;
+	}
+	return Num;
+}
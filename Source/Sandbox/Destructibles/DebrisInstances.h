@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "DebrisInstances.generated.h"
+
+class UInstancedStaticMeshComponent;
+class ADestructibleTarget;
+
+/**
+ * Settled debris that can no longer break, kept as instances instead of actors.
+ * One ISM per destructible class, drawn in the class's debris color (the shape material has no
+ * per-instance color input, so per-piece variation isn't kept).
+ */
+UCLASS()
+class SANDBOX_API ADebrisInstances : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ADebrisInstances();
+
+	void AddPieces(TSubclassOf<ADestructibleTarget> Class, const TArray<FTransform>& Transforms);
+
+	void ForEachPiece(TFunctionRef<void(TSubclassOf<ADestructibleTarget>, const FTransform&)> Func) const;
+
+	int32 GetNumPieces() const;
+
+private:
+	UInstancedStaticMeshComponent* GetOrCreateComponent(TSubclassOf<ADestructibleTarget> Class);
+
+	UPROPERTY()
+	TMap<TSubclassOf<ADestructibleTarget>, UInstancedStaticMeshComponent*> Components;
+};
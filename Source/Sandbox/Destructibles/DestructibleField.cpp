@@ -0,0 +1,413 @@
+#include "DestructibleField.h"
+#include "Sandbox.h"
+#include "DestructibleTarget.h"
+#include "Systems/FireSpreadSubsystem.h"
+#include "Systems/OcclusionGridSubsystem.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/DamageEvents.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+
+ADestructibleField::ADestructibleField()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Only removals replicate. A field spans many grid cells, so it is relevant everywhere
+	// and stays dormant between removals.
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	NetDormancy = DORM_Initial;
+
+	Instances = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("Instances"));
+	Instances->SetCollisionProfileName(TEXT("Destructible"));
+	Instances->SetGenerateOverlapEvents(false);
+	RootComponent = Instances;
+}
+
+void ADestructibleField::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+	ApplyTargetClassVisuals();
+}
+
+void ADestructibleField::BeginPlay()
+{
+	Super::BeginPlay();
+	FieldId = FCrc::StrCrc32(*GetName());
+
+	// Instances added outside Scatter (e.g. painted in the editor) get full health
+	if (InstanceHealth.Num() != Instances->GetInstanceCount())
+	{
+		const float Health = TargetClass ? TargetClass->GetDefaultObject<ADestructibleTarget>()->GetMaxHealth() : 100.f;
+		InstanceHealth.Init(Health, Instances->GetInstanceCount());
+	}
+	if (InstanceIds.Num() != Instances->GetInstanceCount())
+	{
+		InstanceIds.SetNum(Instances->GetInstanceCount());
+		for (uint32& Id : InstanceIds)
+		{
+			Id = NextInstanceId++;
+		}
+	}
+
+	// Fire and blast occlusion only feed server-side damage
+	const bool bServer = GetNetMode() != NM_Client;
+
+	// Flammable instances are fuel for the fire grid without becoming actors
+	UFireSpreadSubsystem* Fire = bServer ? GetWorld()->GetSubsystem<UFireSpreadSubsystem>() : nullptr;
+	if (Fire && TargetClass && TargetClass->GetDefaultObject<ADestructibleTarget>()->IsFlammable())
+	{
+		FTransform InstanceTransform;
+		for (int32 i = 0; i < InstanceIds.Num(); i++)
+		{
+			Instances->GetInstanceTransform(i, InstanceTransform, true);
+			Fire->AddFieldFuel(this, InstanceIds[i], InstanceTransform.GetLocation());
+		}
+	}
+
+	// Each instance blocks blasts on its own; the HISM's bounds cover the whole field
+	UOcclusionGridSubsystem* Occlusion = bServer ? GetWorld()->GetSubsystem<UOcclusionGridSubsystem>() : nullptr;
+	if (Occlusion && Instances->GetStaticMesh())
+	{
+		const FBox LocalBox = Instances->GetStaticMesh()->GetBoundingBox();
+		FTransform InstanceTransform;
+		for (int32 i = 0; i < InstanceIds.Num(); i++)
+		{
+			Instances->GetInstanceTransform(i, InstanceTransform, true);
+			Occlusion->AddBlocker(this, InstanceIds[i], LocalBox, InstanceTransform);
+		}
+	}
+
+	// Removals that arrived before the instance IDs existed
+	if (GetNetMode() == NM_Client)
+	{
+		OnRep_RemovedIds();
+	}
+}
+
+void ADestructibleField::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(ADestructibleField, RemovedIds);
+}
+
+void ADestructibleField::RemoveInstancesAt(TArray<int32>& Indices)
+{
+	if (Indices.Num() == 0) return;
+
+	if (UOcclusionGridSubsystem* Occlusion = GetWorld()->GetSubsystem<UOcclusionGridSubsystem>())
+	{
+		for (int32 Index : Indices)
+		{
+			Occlusion->RemoveBlocker(this, InstanceIds[Index]);
+		}
+	}
+
+	if (HasAuthority())
+	{
+		for (int32 Index : Indices)
+		{
+			RemovedIds.Add(InstanceIds[Index]);
+		}
+		FlushNetDormancy();
+	}
+
+	// The HISM removes highest index first, swapping its last instance into each hole - mirror it
+	Indices.Sort(TGreater<int32>());
+	Instances->RemoveInstances(Indices);
+	for (int32 Index : Indices)
+	{
+		InstanceHealth.RemoveAtSwap(Index, EAllowShrinking::No);
+		InstanceIds.RemoveAtSwap(Index, EAllowShrinking::No);
+	}
+}
+
+void ADestructibleField::OnRep_RemovedIds()
+{
+	// BeginPlay applies whatever arrives before the IDs are set up
+	if (!HasActorBegunPlay()) return;
+
+	TArray<int32> ToRemove;
+	for (; NumRemovedApplied < RemovedIds.Num(); NumRemovedApplied++)
+	{
+		const int32 Index = InstanceIds.IndexOfByKey(RemovedIds[NumRemovedApplied]);
+		if (Index != INDEX_NONE)
+		{
+			ToRemove.AddUnique(Index);
+		}
+	}
+	RemoveInstancesAt(ToRemove);
+}
+
+uint32 ADestructibleField::GetInstancePersistentId(int32 Index) const
+{
+	if (!InstanceIds.IsValidIndex(Index)) return 0;
+	return HashCombine(FieldId, InstanceIds[Index]);
+}
+
+void ADestructibleField::GetInstanceBounds(TArray<FBox>& OutBounds) const
+{
+	const UStaticMesh* StaticMesh = Instances->GetStaticMesh();
+	if (!StaticMesh) return;
+
+	const FBox LocalBox = StaticMesh->GetBoundingBox();
+	OutBounds.Reserve(OutBounds.Num() + Instances->GetInstanceCount());
+	for (int32 i = 0; i < Instances->GetInstanceCount(); i++)
+	{
+		FTransform InstanceTransform;
+		Instances->GetInstanceTransform(i, InstanceTransform, true);
+		OutBounds.Add(LocalBox.TransformBy(InstanceTransform));
+	}
+}
+
+void ADestructibleField::ApplyDestructionState(const TSet<uint32>& DestroyedIds, const TMap<uint32, float>& DamagedHealth)
+{
+	TArray<uint32> ToPromote;
+	for (int32 i = 0; i < InstanceIds.Num(); i++)
+	{
+		if (const float* Health = DamagedHealth.Find(GetInstancePersistentId(i)))
+		{
+			InstanceHealth[i] = *Health;
+			ToPromote.Add(InstanceIds[i]);
+		}
+	}
+
+	// Each promotion swaps the last instance into the hole, so look indices up by ID as we go
+	for (uint32 LocalId : ToPromote)
+	{
+		const int32 Index = InstanceIds.IndexOfByKey(LocalId);
+		if (Index != INDEX_NONE && !DestroyedIds.Contains(GetInstancePersistentId(Index)))
+		{
+			PromoteInstance(Index);
+		}
+	}
+
+	TArray<int32> ToRemove;
+	for (int32 i = 0; i < InstanceIds.Num(); i++)
+	{
+		if (DestroyedIds.Contains(GetInstancePersistentId(i)))
+		{
+			ToRemove.Add(i);
+		}
+	}
+	RemoveInstancesAt(ToRemove);
+}
+
+void ADestructibleField::ApplyTargetClassVisuals()
+{
+	if (!TargetClass) return;
+
+	// Mesh and color come from the class defaults so instances match promoted actors
+	const ADestructibleTarget* CDO = TargetClass->GetDefaultObject<ADestructibleTarget>();
+	UStaticMeshComponent* CDOMesh = CDO->GetMesh();
+	if (!CDOMesh || !CDOMesh->GetStaticMesh()) return;
+
+	Instances->SetStaticMesh(CDOMesh->GetStaticMesh());
+	UMaterialInterface* BaseMat = CDOMesh->GetMaterial(0);
+	if (BaseMat && !Sandbox::IsCosmeticDisabled())
+	{
+		UMaterialInstanceDynamic* Mat = UMaterialInstanceDynamic::Create(BaseMat, this);
+		Mat->SetVectorParameterValue(TEXT("Color"), CDO->GetDebrisColor());
+		Instances->SetMaterial(0, Mat);
+	}
+}
+
+float ADestructibleField::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent,
+	AController* EventInstigator, AActor* DamageCauser)
+{
+	// Each machine has its own field; only the server's promotes instances to replicated actors
+	if (GetNetMode() == NM_Client) return 0.f;
+
+	float TotalDamage = 0.f;
+
+	if (DamageEvent.IsOfType(FPointDamageEvent::ClassID))
+	{
+		const FPointDamageEvent& PointEvent = static_cast<const FPointDamageEvent&>(DamageEvent);
+		TotalDamage = DamageInstance(PointEvent.HitInfo.Item, DamageAmount, DamageEvent, EventInstigator, DamageCauser);
+	}
+	else if (DamageEvent.IsOfType(FRadialDamageEvent::ClassID))
+	{
+		// One call for the whole field - resolve which instances are inside the blast
+		const FRadialDamageEvent& RadialEvent = static_cast<const FRadialDamageEvent&>(DamageEvent);
+		TArray<int32> Hit = Instances->GetInstancesOverlappingSphere(RadialEvent.Origin, RadialEvent.Params.OuterRadius, true);
+
+		// Damage can remove more than the instance it hits (a broken barrel blasts this field
+		// again), so hold IDs and find each one's index just before damaging it
+		TArray<uint32, TInlineAllocator<32>> HitIds;
+		for (int32 Index : Hit)
+		{
+			HitIds.Add(InstanceIds[Index]);
+		}
+		for (uint32 Id : HitIds)
+		{
+			const int32 Index = InstanceIds.IndexOfByKey(Id);
+			if (Index == INDEX_NONE) continue;
+
+			FTransform InstanceTransform;
+			Instances->GetInstanceTransform(Index, InstanceTransform, true);
+			const float Dist = FVector::Dist(InstanceTransform.GetLocation(), RadialEvent.Origin);
+			const float Scale = FMath::Max(0.f, RadialEvent.Params.GetDamageScale(Dist));
+			const float Damage = FMath::Lerp(RadialEvent.Params.MinimumDamage, DamageAmount, Scale);
+
+			TotalDamage += DamageInstance(Index, Damage, FDamageEvent(), EventInstigator, DamageCauser);
+		}
+	}
+
+	return TotalDamage;
+}
+
+float ADestructibleField::DamageInstance(int32 Index, float DamageAmount, FDamageEvent const& DamageEvent,
+	AController* EventInstigator, AActor* DamageCauser)
+{
+	ADestructibleTarget* Target = PromoteInstance(Index);
+	if (!Target) return 0.f;
+
+	return Target->TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
+}
+
+void ADestructibleField::ApplyFireDamage(const TArray<uint32>& Ids, float Damage, TArray<uint32>& OutGone)
+{
+	TSet<uint32> Wanted(Ids);
+	TArray<uint32> Broken;  // Instance IDs
+
+	// One pass over the field, however many instances are burning
+	for (int32 i = 0; i < InstanceIds.Num(); i++)
+	{
+		if (Wanted.Remove(InstanceIds[i]) == 0) continue;
+
+		InstanceHealth[i] -= Damage;
+		if (InstanceHealth[i] <= 0.f)
+		{
+			Broken.Add(InstanceIds[i]);
+		}
+	}
+
+	// Whatever wasn't found has already been promoted or removed
+	OutGone.Append(Wanted.Array());
+
+	// Breaking can remove other instances too (a barrel's blast), so resolve each by ID as we go.
+	// The promoted actor is flammable itself, so its debris keeps burning as actor fuel.
+	for (uint32 Id : Broken)
+	{
+		OutGone.Add(Id);
+		const int32 Index = InstanceIds.IndexOfByKey(Id);
+		if (Index == INDEX_NONE) continue;
+
+		InstanceHealth[Index] = KINDA_SMALL_NUMBER;
+		DamageInstance(Index, Damage, FDamageEvent(), nullptr, nullptr);
+	}
+}
+
+ADestructibleTarget* ADestructibleField::PromoteInstance(int32 Index)
+{
+	if (!TargetClass || !InstanceHealth.IsValidIndex(Index)) return nullptr;
+
+	UWorld* World = GetWorld();
+	if (!World) return nullptr;
+
+	FTransform SpawnTransform;
+	Instances->GetInstanceTransform(Index, SpawnTransform, true);
+	const float Health = InstanceHealth[Index];
+	const uint32 PersistentId = GetInstancePersistentId(Index);
+
+	// Remove first so the new actor doesn't spawn inside the instance's collision.
+	// The promoted actor registers its own occlusion and replicates itself.
+	TArray<int32> Removed = { Index };
+	RemoveInstancesAt(Removed);
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ADestructibleTarget* Target = World->SpawnActor<ADestructibleTarget>(TargetClass, SpawnTransform, Params);
+	if (Target)
+	{
+		Target->SetCurrentHealth(Health);
+		Target->SetPersistentId(PersistentId);
+	}
+	return Target;
+}
+
+void ADestructibleField::Scatter()
+{
+	ClearInstances();
+	ApplyTargetClassVisuals();
+
+	if (ScatterCount <= 0 || MinSpacing <= 0.f) return;
+
+	FRandomStream Rand(RandomSeed);
+
+	// Jittered grid - one candidate per cell guarantees MinSpacing without neighbour searches
+	const int32 CellsX = FMath::Max(1, FMath::FloorToInt(ScatterExtent.X * 2.f / MinSpacing));
+	const int32 CellsY = FMath::Max(1, FMath::FloorToInt(ScatterExtent.Y * 2.f / MinSpacing));
+
+	TArray<int32> Cells;
+	Cells.Reserve(CellsX * CellsY);
+	for (int32 i = 0; i < CellsX * CellsY; i++)
+	{
+		Cells.Add(i);
+	}
+
+	const int32 Count = FMath::Min(ScatterCount, Cells.Num());
+
+	// Partial Fisher-Yates - only the first Count cells are used
+	for (int32 i = 0; i < Count; i++)
+	{
+		Cells.Swap(i, Rand.RandRange(i, Cells.Num() - 1));
+	}
+
+	const float HalfHeight = Instances->GetStaticMesh() ? Instances->GetStaticMesh()->GetBounds().BoxExtent.Z : 50.f;
+	const float Jitter = MinSpacing * 0.25f;
+
+	UWorld* World = GetWorld();
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(DestructibleFieldScatter), false, this);
+
+	TArray<FTransform> NewTransforms;
+	NewTransforms.Reserve(Count);
+
+	for (int32 i = 0; i < Count; i++)
+	{
+		const int32 CellX = Cells[i] % CellsX;
+		const int32 CellY = Cells[i] / CellsX;
+
+		FVector Local(
+			-ScatterExtent.X + (CellX + 0.5f) * MinSpacing + Rand.FRandRange(-Jitter, Jitter),
+			-ScatterExtent.Y + (CellY + 0.5f) * MinSpacing + Rand.FRandRange(-Jitter, Jitter),
+			0.f);
+
+		const float Scale = Rand.FRandRange(ScaleRange.X, ScaleRange.Y);
+		FVector WorldPos = GetActorTransform().TransformPosition(Local);
+
+		if (bTraceToGround && World)
+		{
+			FHitResult Hit;
+			const FVector Up = FVector::UpVector * 5000.f;
+			if (World->LineTraceSingleByChannel(Hit, WorldPos + Up, WorldPos - Up, ECC_WorldStatic, TraceParams))
+			{
+				WorldPos = Hit.ImpactPoint;
+			}
+		}
+		WorldPos.Z += HalfHeight * Scale;
+
+		NewTransforms.Add(FTransform(FRotator(0.f, Rand.FRandRange(0.f, 360.f), 0.f), WorldPos, FVector(Scale)));
+	}
+
+	Instances->AddInstances(NewTransforms, false, true);
+
+	const float Health = TargetClass ? TargetClass->GetDefaultObject<ADestructibleTarget>()->GetMaxHealth() : 100.f;
+	InstanceHealth.Init(Health, NewTransforms.Num());
+
+	InstanceIds.SetNum(NewTransforms.Num());
+	for (uint32& Id : InstanceIds)
+	{
+		Id = NextInstanceId++;
+	}
+}
+
+void ADestructibleField::ClearInstances()
+{
+	Modify();
+	Instances->ClearInstances();
+	InstanceHealth.Reset();
+	InstanceIds.Reset();
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "DestructibleField.generated.h"
+
+class UHierarchicalInstancedStaticMeshComponent;
+class ADestructibleTarget;
+
+/**
+ * Field of intact destructibles stored as HISM instances.
+ * Health lives in a compact array parallel to the instances.
+ * An instance is promoted to a real TargetClass actor the first time damage reaches it,
+ * so breaking, debris and effects still go through ADestructibleTarget.
+ * Every machine loads the same instances; the server replicates the IDs it removes so
+ * clients drop them too and don't draw an instance under its promoted actor.
+ */
+UCLASS()
+class SANDBOX_API ADestructibleField : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ADestructibleField();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent,
+		AController* EventInstigator, AActor* DamageCauser) override;
+
+	// Promote an instance and forward the damage to the spawned actor
+	float DamageInstance(int32 Index, float DamageAmount, struct FDamageEvent const& DamageEvent,
+		AController* EventInstigator, AActor* DamageCauser);
+
+	// Replace the instance at Index with a real actor (nullptr if the index is invalid)
+	ADestructibleTarget* PromoteInstance(int32 Index);
+
+	int32 GetInstanceCount() const { return InstanceHealth.Num(); }
+
+	static constexpr uint32 InvalidInstanceId = MAX_uint32;
+
+	// Local ID of the instance at Index (InvalidInstanceId if out of range). Indices shift as
+	// instances are removed; IDs don't, so hold on to these across anything that can remove.
+	uint32 GetInstanceId(int32 Index) const { return InstanceIds.IsValidIndex(Index) ? InstanceIds[Index] : InvalidInstanceId; }
+
+	// Current index of a local ID, INDEX_NONE once it has been promoted or removed
+	int32 FindInstanceIndex(uint32 Id) const { return InstanceIds.IndexOfByKey(Id); }
+
+	// Persistent ID of an instance, shared with the actor it gets promoted into
+	uint32 GetInstancePersistentId(int32 Index) const;
+
+	// World bounds of every intact instance (navigation obstacles)
+	void GetInstanceBounds(TArray<FBox>& OutBounds) const;
+
+	// Burn damage for instances by ID, applied in place. IDs that broke (promoted and destroyed)
+	// or no longer exist are returned in OutGone.
+	void ApplyFireDamage(const TArray<uint32>& Ids, float Damage, TArray<uint32>& OutGone);
+
+	// Bulk restore from a destruction snapshot - drops destroyed instances, promotes damaged ones
+	void ApplyDestructionState(const TSet<uint32>& DestroyedIds, const TMap<uint32, float>& DamagedHealth);
+
+	// Procedurally scatter ScatterCount instances over ScatterExtent (replaces existing instances)
+	UFUNCTION(CallInEditor, Category = "Field|Scatter")
+	void Scatter();
+
+	UFUNCTION(CallInEditor, Category = "Field|Scatter")
+	void ClearInstances();
+
+protected:
+	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void BeginPlay() override;
+
+	void ApplyTargetClassVisuals();
+
+	// Drop instances (any order) with their occlusion blockers; the server also replicates the removal
+	void RemoveInstancesAt(TArray<int32>& Indices);
+
+	// Client side of RemovedIds - drops instances the server has removed since the last call
+	UFUNCTION()
+	void OnRep_RemovedIds();
+
+	UPROPERTY(VisibleAnywhere)
+	UHierarchicalInstancedStaticMeshComponent* Instances;
+
+	// Actor class each instance represents and is promoted into
+	UPROPERTY(EditAnywhere, Category = "Field")
+	TSubclassOf<ADestructibleTarget> TargetClass;
+
+	// Current health per instance (same order as the HISM instances)
+	UPROPERTY()
+	TArray<float> InstanceHealth;
+
+	// Stable per-instance IDs (same order), survive removals
+	UPROPERTY()
+	TArray<uint32> InstanceIds;
+
+	UPROPERTY()
+	uint32 NextInstanceId = 0;
+
+	// Instance IDs the server has removed, append-only
+	UPROPERTY(ReplicatedUsing = OnRep_RemovedIds)
+	TArray<uint32> RemovedIds;
+
+	// How much of RemovedIds this client has applied
+	int32 NumRemovedApplied = 0;
+
+	// Hash of the actor name, combined with instance IDs
+	uint32 FieldId = 0;
+
+	// === SCATTER ===
+	UPROPERTY(EditAnywhere, Category = "Field|Scatter")
+	int32 ScatterCount = 1000;
+
+	// Half size of the scatter area around the actor
+	UPROPERTY(EditAnywhere, Category = "Field|Scatter")
+	FVector2D ScatterExtent = FVector2D(10000.f, 10000.f);
+
+	// Minimum distance between instances (grid cell size)
+	UPROPERTY(EditAnywhere, Category = "Field|Scatter")
+	float MinSpacing = 200.f;
+
+	UPROPERTY(EditAnywhere, Category = "Field|Scatter")
+	FVector2D ScaleRange = FVector2D(0.8f, 1.4f);
+
+	UPROPERTY(EditAnywhere, Category = "Field|Scatter")
+	int32 RandomSeed = 1337;
+
+	// Drop each instance onto the ground below it
+	UPROPERTY(EditAnywhere, Category = "Field|Scatter")
+	bool bTraceToGround = true;
+};
@@ -1,15 +1,29 @@
 #include "DestructibleTarget.h"
+#include "Sandbox.h"
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "Net/UnrealNetwork.h"
 #include "UObject/ConstructorHelpers.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
 #include "NiagaraSystem.h"
+#include "Systems/AudioEventSubsystem.h"
+#include "Systems/DestructionGovernorSubsystem.h"
+#include "Systems/DestructionStateSubsystem.h"
+#include "Systems/EventStreamSubsystem.h"
+#include "Systems/FireSpreadSubsystem.h"
+#include "Systems/OcclusionGridSubsystem.h"
+#include "Systems/ViewSignificanceSubsystem.h"
+#include "AI/FlowFieldSubsystem.h"
 
 ADestructibleTarget::ADestructibleTarget()
 {
 	PrimaryActorTick.bCanEverTick = false;
 
+	// Server authoritative; intact objects sit dormant in the replication graph until damaged
+	bReplicates = true;
+	NetDormancy = DORM_Initial;
+
 	static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeFinder(
 		TEXT("/Engine/BasicShapes/Cube.Cube"));
 	static ConstructorHelpers::FObjectFinder<UMaterial> MatFinder(
@@ -35,19 +49,60 @@ ADestructibleTarget::ADestructibleTarget()
 void ADestructibleTarget::BeginPlay()
 {
 	Super::BeginPlay();
-	CurrentHealth = MaxHealth;
+
+	// Clients take health from the server (debris health isn't MaxHealth anyway)
+	if (HasAuthority())
+	{
+		CurrentHealth = MaxHealth;
+	}
+
+	// Level-placed objects are identified by name so saved destruction state survives reloads
+	if (PersistentId == 0 && CurrentBreakDepth == 0 && IsNetStartupActor())
+	{
+		PersistentId = FCrc::StrCrc32(*GetName());
+	}
+
+	// Debris moves, so it replicates movement and stays awake
+	if (CurrentBreakDepth > 0 && HasAuthority())
+	{
+		SetReplicateMovement(true);
+		SetNetDormancy(DORM_Awake);
+	}
 
 	if (Mesh)
 	{
 		Mesh->SetSimulatePhysics(CurrentBreakDepth > 0);  // Debris has physics
-		Mesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
-		Mesh->SetCollisionObjectType(ECC_WorldDynamic);
-		Mesh->SetCollisionResponseToAllChannels(ECR_Block);
-		Mesh->SetGenerateOverlapEvents(true);
+		Mesh->SetCollisionProfileName(GetCollisionProfileForDepth(CurrentBreakDepth));
+		Mesh->SetGenerateOverlapEvents(CurrentBreakDepth == 0);  // Debris never needs overlap events
+	}
+
+	// Fire and blast occlusion only feed server-side damage
+	const bool bServer = GetNetMode() != NM_Client;
+
+	if (bFlammable && bServer)
+	{
+		if (UFireSpreadSubsystem* Fire = GetWorld()->GetSubsystem<UFireSpreadSubsystem>())
+		{
+			Fire->AddFuel(this);
+		}
+	}
+
+	// Intact objects block blasts now, debris once it comes to rest (small debris ignores Visibility)
+	UOcclusionGridSubsystem* Occlusion = bServer ? GetWorld()->GetSubsystem<UOcclusionGridSubsystem>() : nullptr;
+	if (Occlusion && Mesh && Mesh->GetCollisionResponseToChannel(ECC_Visibility) == ECR_Block)
+	{
+		if (CurrentBreakDepth == 0)
+		{
+			Occlusion->AddComponent(Mesh);
+		}
+		else
+		{
+			Occlusion->WatchSettling(Mesh);
+		}
 	}
 
 	// Apply color
-	if (Mesh && BaseMaterial)
+	if (Mesh && BaseMaterial && !Sandbox::IsCosmeticDisabled())
 	{
 		UMaterialInstanceDynamic* Mat = UMaterialInstanceDynamic::Create(BaseMaterial, this);
 		Mat->SetVectorParameterValue(TEXT("Color"), DebrisColor);
@@ -55,6 +110,32 @@ void ADestructibleTarget::BeginPlay()
 	}
 }
 
+void ADestructibleTarget::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(ADestructibleTarget, CurrentHealth);
+	DOREPLIFETIME_CONDITION(ADestructibleTarget, CurrentBreakDepth, COND_InitialOnly);
+	DOREPLIFETIME_CONDITION(ADestructibleTarget, DebrisColor, COND_InitialOnly);
+}
+
+void ADestructibleTarget::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UOcclusionGridSubsystem* Occlusion = GetWorld()->GetSubsystem<UOcclusionGridSubsystem>())
+	{
+		Occlusion->RemoveComponent(Mesh);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FName ADestructibleTarget::GetCollisionProfileForDepth(int32 Depth) const
+{
+	// Profiles live in DefaultEngine.ini next to Projectile
+	if (Depth <= 0) return TEXT("Destructible");
+	if (Depth < SmallDebrisDepth) return TEXT("Debris");
+	return TEXT("DebrisSmall");  // Ignores other debris and pawns, still answers explosion overlaps
+}
+
 void ADestructibleTarget::SetDebrisMode(float Scale, const FLinearColor& Color, float Health)
 {
 	DebrisScale = Scale;
@@ -66,12 +147,35 @@ void ADestructibleTarget::SetDebrisMode(float Scale, const FLinearColor& Color,
 	DebrisForce *= 0.6f;
 }
 
+void ADestructibleTarget::RestoreDebrisState(int32 Depth, const FLinearColor& Color)
+{
+	// Scale and health compound with each break, as SpawnDebris passes them down the chain.
+	// Piece count and force start from the class defaults for every piece, so they scale once.
+	if (Depth > 0)
+	{
+		float Scale = DebrisScale;
+		float Health = MaxHealth;
+		for (int32 d = 1; d <= Depth; d++)
+		{
+			Scale = (d == 1) ? DebrisScale : Scale * 0.5f;
+			Health *= 0.3f;
+		}
+		SetDebrisMode(Scale, Color, Health);
+	}
+	DebrisColor = Color;
+	CurrentBreakDepth = Depth;
+}
+
 float ADestructibleTarget::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent,
 	AController* EventInstigator, AActor* DamageCauser)
 {
+	// Breaking spawns and destroys replicated actors - the server's call
+	if (!HasAuthority()) return 0.f;
+
 	float ActualDamage = Super::TakeDamage(DamageAmount, DamageEvent, EventInstigator, DamageCauser);
 	
 	CurrentHealth -= ActualDamage;
+	FlushNetDormancy();
 
 	if (CurrentHealth <= 0.f)
 	{
@@ -81,18 +185,58 @@ float ADestructibleTarget::TakeDamage(float DamageAmount, FDamageEvent const& Da
 			ImpactDir = (GetActorLocation() - DamageCauser->GetActorLocation()).GetSafeNormal();
 		}
 		
+		// Intact objects are navigation obstacles
+		if (CurrentBreakDepth == 0)
+		{
+			if (UFlowFieldSubsystem* FlowFields = GetWorld()->GetSubsystem<UFlowFieldSubsystem>())
+			{
+				FlowFields->NotifyObstaclesChanged();
+			}
+		}
+
+		if (PersistentId != 0)
+		{
+			if (UDestructionStateSubsystem* State = GetWorld()->GetSubsystem<UDestructionStateSubsystem>())
+			{
+				State->NotifyDestroyed(PersistentId);
+			}
+		}
+
 		OnDestroyed();
-		SpawnDebris(ImpactDir);
+		const int32 NumPieces = SpawnDebris(ImpactDir);
+		if (UEventStreamSubsystem* Events = GetWorld()->GetSubsystem<UEventStreamSubsystem>())
+		{
+			Events->Record(ESandboxEvent::Break, GetActorLocation(), this, 0, NumPieces, CurrentBreakDepth);
+		}
 		Destroy();
 	}
 
 	return ActualDamage;
 }
 
+EViewSignificance ADestructibleTarget::GetViewSignificance() const
+{
+	UViewSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UViewSignificanceSubsystem>();
+	return Significance ? Significance->GetSignificance(GetActorLocation()) : EViewSignificance::Near;
+}
+
 void ADestructibleTarget::OnDestroyed()
 {
-	// Only spawn fire effect for original objects or first break
-	if (DestructionEffect && CurrentBreakDepth <= 1)
+	// Small debris breaking is too minor to spend a voice on
+	if (CurrentBreakDepth <= 1)
+	{
+		if (UAudioEventSubsystem* Audio = GetWorld()->GetSubsystem<UAudioEventSubsystem>())
+		{
+			Audio->PostEvent(ESandboxSound::Break, GetActorLocation(), CurrentBreakDepth == 0 ? 1.f : 0.5f);
+		}
+	}
+
+	// Only spawn fire effect for original objects or first break, and first breaks only up close
+	const EViewSignificance Significance = GetViewSignificance();
+	const int32 MaxEffectDepth = Significance == EViewSignificance::Near ? 1 : Significance == EViewSignificance::Mid ? 0 : -1;
+	UDestructionGovernorSubsystem* Governor = GetWorld()->GetSubsystem<UDestructionGovernorSubsystem>();
+	if (DestructionEffect && CurrentBreakDepth <= MaxEffectDepth && !Sandbox::IsCosmeticDisabled()
+		&& (!Governor || Governor->ShouldSpawnEffect()))
 	{
 		float EffectScale = CurrentBreakDepth == 0 ? 1.f : 0.5f;
 		
@@ -120,11 +264,12 @@ void ADestructibleTarget::OnDestroyed()
 	}
 }
 
-void ADestructibleTarget::SpawnDebris(const FVector& ImpactDir)
+int32 ADestructibleTarget::SpawnDebris(const FVector& ImpactDir)
 {
-	// Don't spawn more debris if we've reached max break depth
-	if (CurrentBreakDepth >= MaxBreakDepth) return;
-	if (!CubeMesh || !BaseMaterial) return;
+	// Don't spawn more debris if we've reached max break depth (reduced under load)
+	UDestructionGovernorSubsystem* Governor = GetWorld()->GetSubsystem<UDestructionGovernorSubsystem>();
+	if (CurrentBreakDepth >= (Governor ? Governor->ScaleMaxBreakDepth(MaxBreakDepth) : MaxBreakDepth)) return 0;
+	if (!CubeMesh || !BaseMaterial) return 0;
 
 	UWorld* World = GetWorld();
 	FVector Origin = GetActorLocation();
@@ -134,24 +279,35 @@ void ADestructibleTarget::SpawnDebris(const FVector& ImpactDir)
 	float NewScale = (CurrentBreakDepth == 0) ? DebrisScale : DebrisScale * 0.5f;
 	float NewHealth = MaxHealth * 0.3f;  // Debris is weaker
 
-	for (int32 i = 0; i < DebrisCount; i++)
+	// Nobody is close enough to count the pieces
+	int32 NumPieces = Governor ? Governor->ScaleDebrisCount(DebrisCount) : DebrisCount;
+	if (GetViewSignificance() == EViewSignificance::Far)
+	{
+		NumPieces = FMath::Max(1, NumPieces / 2);
+	}
+
+	int32 NumSpawned = 0;
+	for (int32 i = 0; i < NumPieces; i++)
 	{
 		FVector Offset = FMath::VRand() * 30.f * ActorScale.GetMax();
 		FVector SpawnLoc = Origin + Offset;
 		FRotator SpawnRot = FRotator(FMath::RandRange(0.f, 360.f), FMath::RandRange(0.f, 360.f), 0.f);
 
-		FActorSpawnParameters Params;
-		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-		
-		// Spawn a new DestructibleTarget as debris
-		ADestructibleTarget* Debris = World->SpawnActor<ADestructibleTarget>(
+		// Spawn a new DestructibleTarget as debris - deferred so BeginPlay sees
+		// the break depth (physics, collision profile) and the debris color/health
+		float ScaleVariation = FMath::RandRange(0.7f, 1.3f);
+		FTransform SpawnTransform(SpawnRot, SpawnLoc, ActorScale * NewScale * ScaleVariation);
+
+		ADestructibleTarget* Debris = World->SpawnActorDeferred<ADestructibleTarget>(
 			GetClass(),  // Use same class (or base class for subclasses)
-			SpawnLoc, 
-			SpawnRot, 
-			Params
+			SpawnTransform,
+			nullptr,
+			nullptr,
+			ESpawnActorCollisionHandlingMethod::AlwaysSpawn
 		);
 		
 		if (!Debris) continue;
+		NumSpawned++;
 
 		// Configure as debris
 		Debris->SetBreakDepth(CurrentBreakDepth + 1);
@@ -161,10 +317,7 @@ void ADestructibleTarget::SpawnDebris(const FVector& ImpactDir)
 		FLinearColor VariedColor = DebrisColor * Variation;
 		
 		Debris->SetDebrisMode(NewScale, VariedColor, NewHealth);
-		
-		// Set scale
-		float ScaleVariation = FMath::RandRange(0.7f, 1.3f);
-		Debris->SetActorScale3D(ActorScale * NewScale * ScaleVariation);
+		Debris->FinishSpawning(SpawnTransform);
 
 		// Apply impulse after a tiny delay to let physics initialize
 		FTimerHandle ImpulseTimer;
@@ -183,4 +336,6 @@ void ADestructibleTarget::SpawnDebris(const FVector& ImpactDir)
 			}
 		}, 0.01f, false);
 	}
+
+	return NumSpawned;
 }
@@ -6,6 +6,7 @@
 
 class UStaticMeshComponent;
 class UNiagaraSystem;
+enum class EViewSignificance : uint8;
 
 /**
  * Base class for destructible environment objects.
@@ -22,15 +23,42 @@ public:
 
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent,
 		AController* EventInstigator, AActor* DamageCauser) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	// Set break depth for spawned debris
 	void SetBreakDepth(int32 Depth) { CurrentBreakDepth = Depth; }
 	void SetDebrisMode(float Scale, const FLinearColor& Color, float Health);
 
+	// Configure a freshly (deferred) spawned actor as debris of the given depth, as SpawnDebris would have
+	void RestoreDebrisState(int32 Depth, const FLinearColor& Color);
+
+	// Overwrite current health after BeginPlay (used when promoting from an instanced field)
+	void SetCurrentHealth(float Health) { CurrentHealth = FMath::Min(Health, MaxHealth); }
+
+	UStaticMeshComponent* GetMesh() const { return Mesh; }
+	float GetMaxHealth() const { return MaxHealth; }
+	float GetCurrentHealth() const { return CurrentHealth; }
+	int32 GetBreakDepth() const { return CurrentBreakDepth; }
+	int32 GetMaxBreakDepth() const { return MaxBreakDepth; }
+	bool IsFlammable() const { return bFlammable; }
+	const FLinearColor& GetDebrisColor() const { return DebrisColor; }
+
+	// Stable ID across level loads (0 = transient debris). Used by destruction save state.
+	uint32 GetPersistentId() const { return PersistentId; }
+	void SetPersistentId(uint32 Id) { PersistentId = Id; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void OnDestroyed();
-	virtual void SpawnDebris(const FVector& ImpactDir);
+	// Returns the number of pieces spawned
+	virtual int32 SpawnDebris(const FVector& ImpactDir);
+
+	// Distance class to the nearest local view (cosmetic LOD for effects and debris)
+	EViewSignificance GetViewSignificance() const;
+
+	// Collision profile for a break depth (Destructible / Debris / DebrisSmall)
+	FName GetCollisionProfileForDepth(int32 Depth) const;
 
 	UPROPERTY(VisibleAnywhere)
 	UStaticMeshComponent* Mesh;
@@ -47,19 +75,36 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Destructible")
 	float DebrisForce = 800.f;
 
-	UPROPERTY(EditAnywhere, Category = "Destructible")
+	// Sent once with the spawn, so client debris is tinted like the server's
+	UPROPERTY(EditAnywhere, Replicated, Category = "Destructible")
 	FLinearColor DebrisColor = FLinearColor(0.4f, 0.3f, 0.2f);
 
 	// Maximum times debris can break (0 = original, 1 = first break, etc.)
 	UPROPERTY(EditAnywhere, Category = "Destructible")
 	int32 MaxBreakDepth = 3;
 
+	// Break depth at which debris switches to the reduced DebrisSmall collision profile
+	UPROPERTY(EditAnywhere, Category = "Destructible")
+	int32 SmallDebrisDepth = 2;
+
+	// Burns (and spreads fire) via UFireSpreadSubsystem once ignited by an explosion
+	UPROPERTY(EditAnywhere, Category = "Destructible")
+	bool bFlammable = false;
+
 	// Fire effect on destruction
 	UPROPERTY()
 	UNiagaraSystem* DestructionEffect;
 
+	// Intact objects are dormant; damage flushes them so clients see it
+	UPROPERTY(Replicated)
 	float CurrentHealth;
-	int32 CurrentBreakDepth = 0;  // 0 = original object
+
+	// 0 = original object. Set before FinishSpawning and sent with the spawn, so BeginPlay on
+	// clients sets up debris physics and collision too.
+	UPROPERTY(Replicated)
+	int32 CurrentBreakDepth = 0;
+
+	uint32 PersistentId = 0;
 
 	// Cached mesh for debris
 	UPROPERTY()
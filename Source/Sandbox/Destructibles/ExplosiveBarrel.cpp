@@ -1,4 +1,5 @@
 #include "ExplosiveBarrel.h"
+#include "Sandbox.h"
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Kismet/GameplayStatics.h"
@@ -6,6 +7,15 @@
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
 #include "NiagaraSystem.h"
+#include "Systems/AudioEventSubsystem.h"
+#include "Systems/BlastImpulseSubsystem.h"
+#include "Systems/DestructionGovernorSubsystem.h"
+#include "Systems/EventStreamSubsystem.h"
+#include "Systems/FireSpreadSubsystem.h"
+#include "Systems/ImpactMarkSubsystem.h"
+#include "Systems/OcclusionGridSubsystem.h"
+#include "Systems/ViewSignificanceSubsystem.h"
+#include "Terrain/DeformableTerrainSubsystem.h"
 
 AExplosiveBarrel::AExplosiveBarrel()
 {
@@ -46,8 +56,15 @@ void AExplosiveBarrel::OnDestroyed()
 	UWorld* World = GetWorld();
 	FVector Location = GetActorLocation();
 
-	// Big explosion effect
-	if (ExplosionEffect)
+	if (UEventStreamSubsystem* Events = World->GetSubsystem<UEventStreamSubsystem>())
+	{
+		Events->Record(ESandboxEvent::Explode, Location, this);
+	}
+
+	// Big explosion effect - visible from further than small fires, so only culled when Far
+	UDestructionGovernorSubsystem* Governor = World->GetSubsystem<UDestructionGovernorSubsystem>();
+	if (ExplosionEffect && !Sandbox::IsCosmeticDisabled() && GetViewSignificance() != EViewSignificance::Far
+		&& (!Governor || Governor->ShouldSpawnEffect()))
 	{
 		UNiagaraComponent* FireComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
 			World,
@@ -72,9 +89,37 @@ void AExplosiveBarrel::OnDestroyed()
 		}
 	}
 
+	if (UDeformableTerrainSubsystem* Terrain = World->GetSubsystem<UDeformableTerrainSubsystem>())
+	{
+		Terrain->AddExplosionCrater(Location, ExplosionRadius);
+	}
+	if (UImpactMarkSubsystem* Marks = World->GetSubsystem<UImpactMarkSubsystem>())
+	{
+		Marks->AddExplosionMark(Location, ExplosionRadius);
+	}
+	if (UFireSpreadSubsystem* Fire = World->GetSubsystem<UFireSpreadSubsystem>())
+	{
+		Fire->IgniteExplosion(Location, ExplosionRadius);
+	}
+	if (UBlastImpulseSubsystem* Blasts = World->GetSubsystem<UBlastImpulseSubsystem>())
+	{
+		Blasts->AddBlast(Location, ExplosionRadius, 2.f);
+	}
+	if (UAudioEventSubsystem* Audio = World->GetSubsystem<UAudioEventSubsystem>())
+	{
+		Audio->PostEvent(ESandboxSound::Explosion, Location, 1.5f);
+	}
+
 	// Apply radial damage to nearby destructibles (chain reaction!)
 	TArray<AActor*> IgnoreActors;
 	IgnoreActors.Add(this);
+
+	// Line of sight from the voxel grid rather than a physics trace per component
+	if (UOcclusionGridSubsystem* Occlusion = World->GetSubsystem<UOcclusionGridSubsystem>())
+	{
+		Occlusion->ApplyRadialDamage(ExplosionDamage, Location, ExplosionRadius, this, nullptr, IgnoreActors);
+		return;
+	}
 	
 	UGameplayStatics::ApplyRadialDamage(
 		World,
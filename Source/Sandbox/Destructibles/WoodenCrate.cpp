@@ -9,4 +9,5 @@ AWoodenCrate::AWoodenCrate()
 	DebrisForce = 600.f;
 	DebrisColor = FLinearColor(0.55f, 0.35f, 0.15f);  // Wood brown
 	MaxBreakDepth = 3;  // Wood breaks into many pieces
+	bFlammable = true;
 }
@@ -19,9 +19,14 @@ void UTankInputConfig::Setup()
 	FireAction = NewObject<UInputAction>(this, TEXT("IA_Fire"));
 	FireAction->ValueType = EInputActionValueType::Boolean;
 
+	MachineGunAction = NewObject<UInputAction>(this, TEXT("IA_MachineGun"));
+	MachineGunAction->ValueType = EInputActionValueType::Boolean;
+
 	// === MAPPING CONTEXT ===
 	MappingContext = NewObject<UInputMappingContext>(this, TEXT("IMC_Tank"));
 
+	// Keyboard/mouse and gamepad share one context - each local player adds its own copy
+
 	// W/S for forward/back
 	{
 		FEnhancedActionKeyMapping& W = MappingContext->MapKey(MoveAction, EKeys::W);
@@ -45,6 +50,27 @@ void UTankInputConfig::Setup()
 	{
 		MappingContext->MapKey(FireAction, EKeys::LeftMouseButton);
 	}
+
+	// Right mouse (held) for the coaxial MG
+	{
+		MappingContext->MapKey(MachineGunAction, EKeys::RightMouseButton);
+	}
+
+	// Gamepad - left stick drives, right stick aims, triggers fire
+	{
+		MappingContext->MapKey(MoveAction, EKeys::Gamepad_LeftY);
+		MappingContext->MapKey(TurnAction, EKeys::Gamepad_LeftX);
+
+		// Stick is a -1..1 rate rather than a mouse delta - scale by frame time so aim speed
+		// (about 180 deg/s at full deflection) doesn't depend on frame rate
+		FEnhancedActionKeyMapping& Stick = MappingContext->MapKey(LookAction, EKeys::Gamepad_Right2D);
+		UInputModifierScalarByDelta* StickScale = NewObject<UInputModifierScalarByDelta>(this);
+		StickScale->Scalar = FVector(360.f, 360.f, 1.f);
+		Stick.Modifiers.Add(StickScale);
+
+		MappingContext->MapKey(FireAction, EKeys::Gamepad_RightTrigger);
+		MappingContext->MapKey(MachineGunAction, EKeys::Gamepad_LeftTrigger);
+	}
 }
 
 void UTankInputConfig::AddMappingContext(UEnhancedInputLocalPlayerSubsystem* Subsystem)
@@ -32,6 +32,9 @@ public:
 	UPROPERTY()
 	UInputAction* FireAction;
 
+	UPROPERTY()
+	UInputAction* MachineGunAction;
+
 private:
 	UPROPERTY()
 	UInputMappingContext* MappingContext;
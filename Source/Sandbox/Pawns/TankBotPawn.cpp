@@ -0,0 +1,8 @@
+#include "TankBotPawn.h"
+
+ATankBotPawn::ATankBotPawn(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer
+		.DoNotCreateDefaultSubobject(ATankPawn::CameraBoomName)
+		.DoNotCreateDefaultSubobject(ATankPawn::CameraName))
+{
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TankPawn.h"
+#include "TankBotPawn.generated.h"
+
+/**
+ * AI-driven tank without the player's spring arm and camera.
+ * Construction is an ordinary spawn from the class default object; leaving out the two camera
+ * components is the only per-tank saving. UTankSpawnSubsystem spreads bot waves over frames.
+ */
+UCLASS()
+class SANDBOX_API ATankBotPawn : public ATankPawn
+{
+	GENERATED_BODY()
+
+public:
+	ATankBotPawn(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+};
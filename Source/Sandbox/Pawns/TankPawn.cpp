@@ -1,7 +1,15 @@
 #include "TankPawn.h"
 #include "Components/TankBodyComponent.h"
+#include "Components/TankSuspensionComponent.h"
+#include "AI/TankAIController.h"
 #include "Input/TankInputConfig.h"
 #include "Projectiles/TankProjectile.h"
+#include "Systems/AudioEventSubsystem.h"
+#include "Systems/EventStreamSubsystem.h"
+#include "Systems/FireLatencySubsystem.h"
+#include "Systems/MachineGunSubsystem.h"
+#include "Systems/ProjectilePoolSubsystem.h"
+#include "Systems/ShotAllocationCounter.h"
 #include "Components/BoxComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Camera/CameraComponent.h"
@@ -9,10 +17,20 @@
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
 
-ATankPawn::ATankPawn()
+DECLARE_CYCLE_STAT(TEXT("TankPawn Tick"), STAT_TankPawnTick, STATGROUP_Game);
+
+const FName ATankPawn::CameraBoomName(TEXT("CameraBoom"));
+const FName ATankPawn::CameraName(TEXT("Camera"));
+
+ATankPawn::ATankPawn(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
 	PrimaryActorTick.bCanEverTick = true;
 
+	// Tanks placed in the level are bots; spawned bots call SpawnDefaultController themselves
+	AIControllerClass = ATankAIController::StaticClass();
+	AutoPossessAI = EAutoPossessAI::PlacedInWorld;
+
 	// === PHYSICS CHASSIS (physics setup deferred to BeginPlay) ===
 	Chassis = CreateDefaultSubobject<UBoxComponent>(TEXT("Chassis"));
 	Chassis->SetBoxExtent(FVector(300.f, 200.f, 60.f));  // 2x size
@@ -22,24 +40,33 @@ ATankPawn::ATankPawn()
 	// === TANK BODY (visuals only) ===
 	TankBody = CreateDefaultSubobject<UTankBodyComponent>(TEXT("TankBody"));
 	TankBody->SetupAttachment(Chassis);
-	TankBody->SetRelativeLocation(FVector(0.f, 0.f, -25.f));  // Adjusted to sit on ground
+	TankBody->SetRelativeLocation(FVector(0.f, 0.f, -40.f));  // Treads touch the ground at suspension rest height
 	TankBody->SetRelativeScale3D(FVector(2.f, 2.f, 2.f));  // 2x visual size
 
+	// === SUSPENSION ===
+	Suspension = CreateDefaultSubobject<UTankSuspensionComponent>(TEXT("Suspension"));
+
 	// === CAMERA ===
-	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
-	CameraBoom->SetupAttachment(Chassis);
-	CameraBoom->TargetArmLength = 1200.f;
-	CameraBoom->SetRelativeLocation(FVector(0.f, 0.f, 100.f));
-	CameraBoom->SocketOffset = FVector(0.f, 0.f, 200.f);  // Camera higher, looks down at tank
-	CameraBoom->bDoCollisionTest = true;
-	CameraBoom->bUsePawnControlRotation = false;
-	CameraBoom->bInheritPitch = false;
-	CameraBoom->bInheritYaw = false;
-	CameraBoom->bInheritRoll = false;
-	CameraBoom->SetUsingAbsoluteRotation(true);
-
-	Camera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
-	Camera->SetupAttachment(CameraBoom);
+	CameraBoom = CreateOptionalDefaultSubobject<USpringArmComponent>(CameraBoomName);
+	if (CameraBoom)
+	{
+		CameraBoom->SetupAttachment(Chassis);
+		CameraBoom->TargetArmLength = 1200.f;
+		CameraBoom->SetRelativeLocation(FVector(0.f, 0.f, 100.f));
+		CameraBoom->SocketOffset = FVector(0.f, 0.f, 200.f);  // Camera higher, looks down at tank
+		CameraBoom->bDoCollisionTest = true;
+		CameraBoom->bUsePawnControlRotation = false;
+		CameraBoom->bInheritPitch = false;
+		CameraBoom->bInheritYaw = false;
+		CameraBoom->bInheritRoll = false;
+		CameraBoom->SetUsingAbsoluteRotation(true);
+
+		Camera = CreateOptionalDefaultSubobject<UCameraComponent>(CameraName);
+		if (Camera)
+		{
+			Camera->SetupAttachment(CameraBoom);
+		}
+	}
 }
 
 void ATankPawn::BeginPlay()
@@ -53,7 +80,7 @@ void ATankPawn::BeginPlay()
 		Chassis->SetSimulatePhysics(true);
 		Chassis->SetEnableGravity(true);
 		Chassis->SetMassOverrideInKg(NAME_None, 8000.f);
-		Chassis->SetLinearDamping(2.f);
+		Chassis->SetLinearDamping(0.1f);  // Traction comes from the suspension
 		Chassis->SetAngularDamping(2.f);
 		Chassis->SetCenterOfMass(FVector(0.f, 0.f, -80.f));
 	}
@@ -61,6 +88,7 @@ void ATankPawn::BeginPlay()
 
 void ATankPawn::Tick(float DeltaTime)
 {
+	SCOPE_CYCLE_COUNTER(STAT_TankPawnTick);
 	Super::Tick(DeltaTime);
 	ApplyMovement();
 	UpdateTurret();
@@ -70,10 +98,18 @@ void ATankPawn::Tick(float DeltaTime)
 	{
 		FireCooldown -= DeltaTime;
 	}
+	UpdateMachineGun(DeltaTime);
 
-	// Tread animation from input (consistent speed regardless of terrain)
-	float TreadForward = ThrottleInput * 1000.f;  // Constant rate based on input
+	// Tread animation from ground contact; spins freely from input when airborne
+	float TreadForward = ThrottleInput * 1000.f;
 	float TreadTurn = TurnInput * 500.f;
+	if (Suspension && Suspension->GetNumGroundedWheels() > 0)
+	{
+		float Left = Suspension->GetLeftTrackSpeed() * TreadSpeedScale;
+		float Right = Suspension->GetRightTrackSpeed() * TreadSpeedScale;
+		TreadForward = (Left + Right) * 0.5f;
+		TreadTurn = (Left - Right) * 0.5f;
+	}
 	TankBody->UpdateTreads(TreadForward, TreadTurn);
 }
 
@@ -81,51 +117,24 @@ void ATankPawn::ApplyMovement()
 {
 	if (!Chassis->IsSimulatingPhysics()) return;
 
-	FVector Velocity = Chassis->GetPhysicsLinearVelocity();
-	float Speed = Velocity.Size();
-
-	// Drive force - apply along current forward (follows terrain tilt)
-	if (FMath::Abs(ThrottleInput) > 0.01f && Speed < MaxSpeed)
-	{
-		FVector Force = GetActorForwardVector() * ThrottleInput * DriveForce;
-		Chassis->AddForce(Force);
-	}
+	// Drive, traction, braking and ride height come from UTankSuspensionComponent.
+	// Only skid-steer yaw is applied here, and only with the tracks on the ground.
+	if (Suspension && Suspension->GetNumGroundedWheels() == 0) return;
 
 	// Turn - directly set angular velocity (more reliable than torque)
 	float TargetAngularVel = TurnInput * 120.f; // 120 degrees per second at full input (faster turn)
 	FVector CurrentAngVel = Chassis->GetPhysicsAngularVelocityInDegrees();
 	// Only control yaw, let physics handle pitch/roll
 	Chassis->SetPhysicsAngularVelocityInDegrees(FVector(CurrentAngVel.X, CurrentAngVel.Y, TargetAngularVel));
-
-	// Brake when no throttle input
-	if (FMath::Abs(ThrottleInput) < 0.01f)
-	{
-		FVector Brake = -Velocity * 5000.f;
-		Brake.Z = 0.f;
-		Chassis->AddForce(Brake);
-	}
-	
-	// Anti-flip stabilization - apply corrective torque if tilting too much
-	FRotator Rot = GetActorRotation();
-	float MaxTilt = 45.f;
-	
-	if (FMath::Abs(Rot.Pitch) > MaxTilt)
-	{
-		float Correction = -Rot.Pitch * 30000.f;
-		Chassis->AddTorqueInDegrees(FVector(0.f, Correction, 0.f));
-	}
-	
-	if (FMath::Abs(Rot.Roll) > MaxTilt)
-	{
-		float Correction = -Rot.Roll * 30000.f;
-		Chassis->AddTorqueInDegrees(FVector(Correction, 0.f, 0.f));
-	}
 }
 
 void ATankPawn::UpdateTurret()
 {
 	// Camera follows aim (absolute world rotation)
-	CameraBoom->SetWorldRotation(FRotator(AimPitch, AimYaw, 0.f));
+	if (CameraBoom)
+	{
+		CameraBoom->SetWorldRotation(FRotator(AimPitch, AimYaw, 0.f));
+	}
 
 	// Turret aims same direction as camera
 	// AimPitch is negative when looking up (camera convention), barrel pitch is positive when elevated
@@ -155,9 +164,32 @@ void ATankPawn::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 		EIC->BindAction(InputConfig->TurnAction, ETriggerEvent::Completed, this, &ATankPawn::HandleTurn);
 		EIC->BindAction(InputConfig->LookAction, ETriggerEvent::Triggered, this, &ATankPawn::HandleLook);
 		EIC->BindAction(InputConfig->FireAction, ETriggerEvent::Started, this, &ATankPawn::HandleFire);
+		EIC->BindAction(InputConfig->MachineGunAction, ETriggerEvent::Started, this, &ATankPawn::HandleMachineGun);
+		EIC->BindAction(InputConfig->MachineGunAction, ETriggerEvent::Completed, this, &ATankPawn::HandleMachineGun);
 	}
 }
 
+void ATankPawn::SetDriveInput(float Throttle, float Turn)
+{
+	ThrottleInput = FMath::Clamp(Throttle, -1.f, 1.f);
+	TurnInput = FMath::Clamp(Turn, -1.f, 1.f);
+}
+
+void ATankPawn::SetAim(float Yaw, float Pitch)
+{
+	// Barrel elevation to the camera convention, once - UpdateTurret negates it back for SetTurretAim
+	AimYaw = FMath::UnwindDegrees(Yaw);
+	AimPitch = FMath::Clamp(-Pitch, -UTankBodyComponent::MaxBarrelPitch, 0.f);
+	bBarrelAim = true;
+}
+
+FRotator ATankPawn::GetFireRotation() const
+{
+	// Players fire at the crosshair (camera direction); controllers that set a barrel aim fire
+	// along the barrel, matching UTankBodyComponent::GetMuzzleDirection
+	return FRotator(bBarrelAim ? -AimPitch : AimPitch, AimYaw, 0.f);
+}
+
 void ATankPawn::HandleMove(const FInputActionValue& Value)
 {
 	ThrottleInput = Value.Get<float>();
@@ -173,32 +205,105 @@ void ATankPawn::HandleLook(const FInputActionValue& Value)
 	FVector2D Input = Value.Get<FVector2D>();
 	AimYaw = FMath::UnwindDegrees(AimYaw + Input.X * 0.5f);
 	AimPitch = FMath::Clamp(AimPitch - Input.Y * 0.5f, -50.f, 0.f);
+	bBarrelAim = false;
 }
 
 void ATankPawn::HandleFire(const FInputActionValue& Value)
 {
+	TryFire();
+}
+
+bool ATankPawn::TryFire()
+{
+	UFireLatencySubsystem* Latency = GetWorld()->GetSubsystem<UFireLatencySubsystem>();
+	const uint32 ShotId = Latency ? Latency->BeginShot() : 0;
+
 	if (FireCooldown <= 0.f)
 	{
-		Fire();
+		Fire(ShotId);
 		FireCooldown = FireRate;
+		return true;
 	}
+	if (Latency)
+	{
+		Latency->CancelShot(ShotId);
+	}
+	return false;
 }
 
-void ATankPawn::Fire()
+void ATankPawn::HandleMachineGun(const FInputActionValue& Value)
 {
-	if (!TankBody) return;
+	bMachineGunFiring = Value.Get<bool>();
+}
 
-	// Fire direction matches camera/crosshair (screen center)
-	FRotator AimRot(AimPitch, AimYaw, 0.f);
+void ATankPawn::Fire(uint32 ShotId)
+{
+	SANDBOX_SHOT_ALLOC_SCOPE();
+
+	UFireLatencySubsystem* Latency = GetWorld()->GetSubsystem<UFireLatencySubsystem>();
+	if (!TankBody)
+	{
+		if (Latency) Latency->CancelShot(ShotId);
+		return;
+	}
+	if (Latency) Latency->MarkStage(ShotId, EFireStage::Fire);
+
+	// Fire direction matches camera/crosshair (screen center), or the barrel for SetAim
+	FRotator AimRot = GetFireRotation();
 	FVector FireDir = AimRot.Vector();
 	
 	// Spawn from muzzle location
 	FVector MuzzlePos = TankBody->GetMuzzleLocation();
 	FVector SpawnPos = MuzzlePos + FireDir * 50.f;
 
-	FActorSpawnParameters Params;
-	Params.Owner = this;
-	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	// Pooled shell - relaunched rather than spawned
+	UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>();
+	ATankProjectile* Shell = Pool ? Pool->Acquire(this, SpawnPos, AimRot, Latency ? ShotId : 0) : nullptr;
+	if (Shell)
+	{
+		if (UAudioEventSubsystem* Audio = GetWorld()->GetSubsystem<UAudioEventSubsystem>())
+		{
+			Audio->PostEvent(ESandboxSound::Shot, MuzzlePos);
+		}
+		if (UEventStreamSubsystem* Events = GetWorld()->GetSubsystem<UEventStreamSubsystem>())
+		{
+			Events->Record(ESandboxEvent::Fire, MuzzlePos, this, ShotId);
+		}
+	}
+	if (Latency)
+	{
+		if (Shell)
+		{
+			Latency->MarkStage(ShotId, EFireStage::Spawn);
+		}
+		else
+		{
+			Latency->CancelShot(ShotId);
+		}
+	}
+}
+
+void ATankPawn::UpdateMachineGun(float DeltaTime)
+{
+	MachineGunCooldown -= DeltaTime;
+	if (!bMachineGunFiring || !TankBody || MachineGunRate <= 0.f)
+	{
+		MachineGunCooldown = FMath::Max(MachineGunCooldown, 0.f);
+		return;
+	}
+
+	UMachineGunSubsystem* MachineGun = GetWorld()->GetSubsystem<UMachineGunSubsystem>();
+	if (!MachineGun) return;
+
+	const FRotator AimRot = GetFireRotation();
+	const FVector Dir = AimRot.Vector();
+	const FVector Muzzle = TankBody->GetMuzzleLocation() + FRotationMatrix(AimRot).GetUnitAxis(EAxis::Y) * MachineGunOffset;
+	const float ConeRadians = FMath::DegreesToRadians(MachineGunSpread);
 
-	GetWorld()->SpawnActor<ATankProjectile>(ATankProjectile::StaticClass(), SpawnPos, AimRot, Params);
+	// Every round due this frame - rate holds even at low frame rates
+	while (MachineGunCooldown <= 0.f)
+	{
+		MachineGun->QueueShot(this, Muzzle, FMath::VRandCone(Dir, ConeRadians));
+		MachineGunCooldown += 1.f / MachineGunRate;
+	}
 }
@@ -6,6 +6,7 @@
 
 class UBoxComponent;
 class UTankBodyComponent;
+class UTankSuspensionComponent;
 class USpringArmComponent;
 class UCameraComponent;
 class UTankInputConfig;
@@ -18,6 +19,7 @@ struct FInputActionValue;
  * - W/S: Drive forward/backward
  * - A/D: Turn hull
  * - Mouse: Aim turret/camera
+ * - Right mouse (hold): Coaxial machine gun
  */
 UCLASS()
 class SANDBOX_API ATankPawn : public APawn
@@ -25,9 +27,32 @@ class SANDBOX_API ATankPawn : public APawn
 	GENERATED_BODY()
 
 public:
-	ATankPawn();
+	ATankPawn(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	// Optional subobjects - ATankBotPawn skips them
+	static const FName CameraBoomName;
+	static const FName CameraName;
 
 	UTankBodyComponent* GetTankBody() const { return TankBody; }
+	UBoxComponent* GetChassis() const { return Chassis; }
+
+	// Drive input for non-player controllers (same path as Enhanced Input, -1..1)
+	void SetDriveInput(float Throttle, float Turn);
+
+	// World-space aim for non-player controllers. Pitch is barrel elevation (positive up, clamped to the barrel's travel),
+	// the convention of SetTurretAim and aim solutions; shells then leave along the barrel.
+	void SetAim(float Yaw, float Pitch);
+
+	// Fire the main gun if it has reloaded (same path as the fire input)
+	bool TryFire();
+	bool CanFire() const { return FireCooldown <= 0.f; }
+
+	// Hold the coaxial MG trigger
+	void SetMachineGunFiring(bool bFiring) { bMachineGunFiring = bFiring; }
+
+	float GetThrottleInput() const { return ThrottleInput; }
+	float GetDriveForce() const { return DriveForce; }
+	float GetMaxSpeed() const { return MaxSpeed; }
 
 protected:
 	virtual void BeginPlay() override;
@@ -43,7 +68,11 @@ private:
 	UPROPERTY(VisibleAnywhere, Category = "Components")
 	UTankBodyComponent* TankBody;
 
-	// Camera
+	// Road-wheel suspension, traction and drive
+	UPROPERTY(VisibleAnywhere, Category = "Components")
+	UTankSuspensionComponent* Suspension;
+
+	// Camera (absent on bots)
 	UPROPERTY(VisibleAnywhere, Category = "Components")
 	USpringArmComponent* CameraBoom;
 
@@ -54,10 +83,16 @@ private:
 	UPROPERTY()
 	UTankInputConfig* InputConfig;
 
-	// Aim state (world-space, decoupled from hull)
+	// Aim state (world-space, decoupled from hull). AimPitch uses the camera convention, negative when aiming up.
 	float AimYaw = 0.f;
 	float AimPitch = -20.f;
 
+	// Set by SetAim, cleared by look input - fire along the barrel instead of the camera
+	bool bBarrelAim = false;
+
+	// Launch rotation for shells and MG rounds
+	FRotator GetFireRotation() const;
+
 	// Input state
 	float ThrottleInput = 0.f;
 	float TurnInput = 0.f;
@@ -68,6 +103,22 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Tank|Combat")
 	float FireRate = 0.5f;
 
+	// Coaxial MG - hitscan rounds resolved by UMachineGunSubsystem
+	bool bMachineGunFiring = false;
+	float MachineGunCooldown = 0.f;
+
+	// Rounds per second
+	UPROPERTY(EditAnywhere, Category = "Tank|Combat")
+	float MachineGunRate = 18.f;
+
+	// Cone half-angle in degrees
+	UPROPERTY(EditAnywhere, Category = "Tank|Combat")
+	float MachineGunSpread = 0.8f;
+
+	// Coax sits beside the main gun (cm to the right of its muzzle)
+	UPROPERTY(EditAnywhere, Category = "Tank|Combat")
+	float MachineGunOffset = 40.f;
+
 	// Tuning
 	UPROPERTY(EditAnywhere, Category = "Tank|Movement")
 	float DriveForce = 8000000.f;  // 2x+ for bigger tank
@@ -75,6 +126,10 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Tank|Movement")
 	float TurnTorque = 200000000.f;  // More torque for bigger tank
 
+	// Tread animation units per cm/s of ground speed
+	UPROPERTY(EditAnywhere, Category = "Tank|Movement")
+	float TreadSpeedScale = 0.42f;
+
 	UPROPERTY(EditAnywhere, Category = "Tank|Movement")
 	float MaxSpeed = 2400.f;  // 2x speed
 
@@ -83,9 +138,11 @@ private:
 	void HandleTurn(const FInputActionValue& Value);
 	void HandleLook(const FInputActionValue& Value);
 	void HandleFire(const FInputActionValue& Value);
+	void HandleMachineGun(const FInputActionValue& Value);
 
 	// Update functions
 	void ApplyMovement();
 	void UpdateTurret();
-	void Fire();
+	void Fire(uint32 ShotId = 0);
+	void UpdateMachineGun(float DeltaTime);
 };
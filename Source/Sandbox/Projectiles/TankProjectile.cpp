@@ -1,19 +1,35 @@
 #include "TankProjectile.h"
+#include "Sandbox.h"
 #include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Engine/DamageEvents.h"
 #include "Engine/OverlapResult.h"
 #include "UObject/ConstructorHelpers.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Kismet/GameplayStatics.h"
-#include "NiagaraFunctionLibrary.h"
-#include "NiagaraComponent.h"
+#include "Destructibles/DestructibleField.h"
+#include "Systems/AudioEventSubsystem.h"
+#include "Systems/BlastImpulseSubsystem.h"
+#include "Systems/DestructionGovernorSubsystem.h"
+#include "Systems/EventStreamSubsystem.h"
+#include "Systems/FireSpreadSubsystem.h"
+#include "Systems/FireLatencySubsystem.h"
+#include "Systems/ProjectilePoolSubsystem.h"
+#include "Systems/ShotAllocationCounter.h"
+#include "Systems/ViewSignificanceSubsystem.h"
+#include "Systems/ImpactMarkSubsystem.h"
+#include "Terrain/DeformableTerrainSubsystem.h"
 #include "NiagaraSystem.h"
 
 ATankProjectile::ATankProjectile()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
+	// Clients only see the flight, hits are resolved on the server
+	bReplicates = true;
+	SetReplicatingMovement(true);
+
 	// Simple visible mesh - no collision, just visual
 	static ConstructorHelpers::FObjectFinder<UStaticMesh> SphereMesh(
 		TEXT("/Engine/BasicShapes/Sphere.Sphere"));
@@ -50,8 +66,8 @@ void ATankProjectile::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Orange glowing material
-	if (Mesh && Mesh->GetMaterial(0))
+	// Orange glowing material - once per shell, pooled shells keep it across launches
+	if (Mesh && Mesh->GetMaterial(0) && !Sandbox::IsCosmeticDisabled())
 	{
 		UMaterialInstanceDynamic* Mat = UMaterialInstanceDynamic::Create(Mesh->GetMaterial(0), this);
 		Mat->SetVectorParameterValue(TEXT("Color"), FLinearColor(1.f, 0.5f, 0.f));
@@ -61,14 +77,96 @@ void ATankProjectile::BeginPlay()
 	PrevLocation = GetActorLocation();
 }
 
+void ATankProjectile::Launch(AActor* Shooter, const FVector& Location, const FRotator& Rotation, uint32 InShotId)
+{
+	SetOwner(Shooter);
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(true);
+	SetNetDormancy(DORM_Awake);
+
+	Movement->SetUpdatedComponent(Mesh);
+	Movement->Velocity = Rotation.Vector() * Speed;
+	Movement->Activate(true);
+
+	QueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(TankProjectile), false, this);
+	QueryParams.AddIgnoredActor(Shooter);
+
+	Age = 0.f;
+	PrevLocation = Location;
+	ShotId = InShotId;
+}
+
+void ATankProjectile::Park()
+{
+	SetActorHiddenInGame(true);
+	SetActorTickEnabled(false);
+	Movement->StopMovementImmediately();
+	Movement->Deactivate();
+	SetOwner(nullptr);
+
+	// Going dormant now could close the channel before the hide is sent, leaving a frozen
+	// shell on clients - push the update out and leave dormancy to the pool
+	ForceNetUpdate();
+	ParkTime = GetWorld()->GetTimeSeconds();
+}
+
+float ATankProjectile::GetGravityScale() const
+{
+	return Movement ? Movement->ProjectileGravityScale : 1.f;
+}
+
+void ATankProjectile::Retire()
+{
+	if (ShotId != 0)
+	{
+		if (UFireLatencySubsystem* Latency = GetWorld()->GetSubsystem<UFireLatencySubsystem>())
+		{
+			Latency->EndShot(ShotId);
+		}
+		ShotId = 0;
+	}
+	ShotAllocationCounter::NotifyShotFinished();
+
+	if (UProjectilePoolSubsystem* Pool = GetWorld()->GetSubsystem<UProjectilePoolSubsystem>())
+	{
+		Pool->Release(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void ATankProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ShotId != 0)
+	{
+		if (UFireLatencySubsystem* Latency = GetWorld()->GetSubsystem<UFireLatencySubsystem>())
+		{
+			Latency->EndShot(ShotId);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ATankProjectile::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+	if (!HasAuthority()) return;
+	SANDBOX_SHOT_ALLOC_SCOPE();
+
+	UFireLatencySubsystem* Latency = ShotId != 0 ? GetWorld()->GetSubsystem<UFireLatencySubsystem>() : nullptr;
+	if (Latency && Age == 0.f)
+	{
+		Latency->MarkStage(ShotId, EFireStage::FirstTick);
+	}
 
 	Age += DeltaTime;
 	if (Age > LifeTime)
 	{
-		Destroy();
+		Retire();
 		return;
 	}
 
@@ -76,12 +174,13 @@ void ATankProjectile::Tick(float DeltaTime)
 	FVector CurrentLocation = GetActorLocation();
 	
 	FHitResult Hit;
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
-	Params.AddIgnoredActor(GetOwner());
-
-	if (GetWorld()->LineTraceSingleByChannel(Hit, PrevLocation, CurrentLocation, ECC_Visibility, Params))
+	if (GetWorld()->LineTraceSingleByChannel(Hit, PrevLocation, CurrentLocation, ECC_Visibility, QueryParams))
 	{
+		if (Latency) Latency->MarkStage(ShotId, EFireStage::Hit);
+		if (UEventStreamSubsystem* Events = GetWorld()->GetSubsystem<UEventStreamSubsystem>())
+		{
+			Events->Record(ESandboxEvent::Hit, Hit.ImpactPoint, Hit.GetActor(), ShotId);
+		}
 		Explode(Hit.ImpactPoint);
 		return;
 	}
@@ -95,19 +194,34 @@ void ATankProjectile::Explode(const FVector& Location)
 	if (!World) return;
 
 	// Find all actors in explosion radius using overlap
-	TArray<FOverlapResult> Overlaps;
+	OverlapScratch.Reset();
 	FCollisionShape Sphere = FCollisionShape::MakeSphere(ExplosionRadius);
-	FCollisionQueryParams Params;
-	Params.AddIgnoredActor(this);
-	Params.AddIgnoredActor(GetOwner());
+	int32 NumDamaged = 0;
 
-	if (World->OverlapMultiByChannel(Overlaps, Location, FQuat::Identity, ECC_WorldDynamic, Sphere, Params))
+	if (World->OverlapMultiByChannel(OverlapScratch, Location, FQuat::Identity, ECC_WorldDynamic, Sphere, QueryParams))
 	{
-		TSet<AActor*> DamagedActors;  // Avoid damaging same actor twice
+		// Avoid damaging same actor twice - a blast touches few actors, so a linear scan beats a set
+		TArray<AActor*, TInlineAllocator<16>> DamagedActors;
+		TArray<TPair<AActor*, FPointDamageEvent>, TInlineAllocator<16>> InstanceHits;
+		TArray<uint32, TInlineAllocator<16>> InstanceHitIds;  // Field instance IDs, same order
 		
-		for (const FOverlapResult& Overlap : Overlaps)
+		for (const FOverlapResult& Overlap : OverlapScratch)
 		{
 			AActor* HitActor = Overlap.GetActor();
+
+			// Instanced fields take damage per instance, not once per actor
+			if (HitActor && Overlap.ItemIndex != INDEX_NONE && Cast<UInstancedStaticMeshComponent>(Overlap.GetComponent()))
+			{
+				FPointDamageEvent PointEvent;
+				PointEvent.Damage = ExplosionDamage;
+				PointEvent.HitInfo.Item = Overlap.ItemIndex;
+				PointEvent.HitInfo.Component = Overlap.Component;
+				InstanceHits.Add(TPair<AActor*, FPointDamageEvent>(HitActor, PointEvent));
+				const ADestructibleField* Field = Cast<ADestructibleField>(HitActor);
+				InstanceHitIds.Add(Field ? Field->GetInstanceId(Overlap.ItemIndex) : ADestructibleField::InvalidInstanceId);
+				continue;
+			}
+
 			if (HitActor && !DamagedActors.Contains(HitActor))
 			{
 				DamagedActors.Add(HitActor);
@@ -118,33 +232,66 @@ void ATankProjectile::Explode(const FVector& Location)
 					GetOwner() ? GetOwner()->GetInstigatorController() : nullptr, this);
 			}
 		}
+
+		// Promotion, and barrels it breaks blasting the field again, remove and reorder instances -
+		// find each field instance's index by ID just before damaging it, skipping ones that are gone
+		for (int32 i = 0; i < InstanceHits.Num(); i++)
+		{
+			TPair<AActor*, FPointDamageEvent>& InstanceHit = InstanceHits[i];
+			if (!IsValid(InstanceHit.Key)) continue;
+
+			if (const ADestructibleField* Field = Cast<ADestructibleField>(InstanceHit.Key))
+			{
+				InstanceHit.Value.HitInfo.Item = Field->FindInstanceIndex(InstanceHitIds[i]);
+				if (InstanceHit.Value.HitInfo.Item == INDEX_NONE) continue;
+			}
+			InstanceHit.Key->TakeDamage(ExplosionDamage, InstanceHit.Value,
+				GetOwner() ? GetOwner()->GetInstigatorController() : nullptr, this);
+		}
+		NumDamaged = DamagedActors.Num() + InstanceHits.Num();
 	}
 
-	// Spawn Niagara explosion effect
-	if (ExplosionEffect)
+	UFireLatencySubsystem* Latency = ShotId != 0 ? World->GetSubsystem<UFireLatencySubsystem>() : nullptr;
+	if (Latency) Latency->MarkStage(ShotId, EFireStage::Damage);
+
+	if (UEventStreamSubsystem* Events = World->GetSubsystem<UEventStreamSubsystem>())
 	{
-		UNiagaraComponent* ExplosionComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
-			World,
-			ExplosionEffect,
-			Location,
-			FRotator::ZeroRotator,
-			FVector(1.5f),
-			true, true,
-			ENCPoolMethod::None
-		);
+		Events->Record(ESandboxEvent::Explode, Location, this, ShotId, NumDamaged);
+	}
 
-		if (ExplosionComp)
+	if (UDeformableTerrainSubsystem* Terrain = World->GetSubsystem<UDeformableTerrainSubsystem>())
+	{
+		Terrain->AddExplosionCrater(Location, ExplosionRadius);
+	}
+	if (UImpactMarkSubsystem* Marks = World->GetSubsystem<UImpactMarkSubsystem>())
+	{
+		Marks->AddExplosionMark(Location, ExplosionRadius);
+	}
+	if (UFireSpreadSubsystem* Fire = World->GetSubsystem<UFireSpreadSubsystem>())
+	{
+		Fire->IgniteExplosion(Location, ExplosionRadius);
+	}
+	if (UBlastImpulseSubsystem* Blasts = World->GetSubsystem<UBlastImpulseSubsystem>())
+	{
+		Blasts->AddBlast(Location, ExplosionRadius);
+	}
+	if (UAudioEventSubsystem* Audio = World->GetSubsystem<UAudioEventSubsystem>())
+	{
+		Audio->PostEvent(ESandboxSound::Explosion, Location);
+	}
+
+	// Spawn Niagara explosion effect, unless every view is far away
+	UViewSignificanceSubsystem* Significance = World->GetSubsystem<UViewSignificanceSubsystem>();
+	const bool bVisible = !Significance || Significance->GetSignificance(Location) != EViewSignificance::Far;
+	UDestructionGovernorSubsystem* Governor = World->GetSubsystem<UDestructionGovernorSubsystem>();
+	if (ExplosionEffect && bVisible && !Sandbox::IsCosmeticDisabled() && (!Governor || Governor->ShouldSpawnEffect()))
+	{
+		if (UProjectilePoolSubsystem* Pool = World->GetSubsystem<UProjectilePoolSubsystem>())
 		{
-			FTimerHandle TimerHandle;
-			World->GetTimerManager().SetTimer(TimerHandle, [ExplosionComp]()
-			{
-				if (ExplosionComp && ExplosionComp->IsValidLowLevel())
-				{
-					ExplosionComp->Deactivate();
-				}
-			}, 1.5f, false);
+			Pool->SpawnEffect(ExplosionEffect, Location, FVector(1.5f), 1.5f);
 		}
 	}
+	if (Latency) Latency->MarkStage(ShotId, EFireStage::Effects);
 
-	Destroy();
+	Retire();
 }
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "CollisionQueryParams.h"
+#include "Engine/OverlapResult.h"
 #include "TankProjectile.generated.h"
 
 class UProjectileMovementComponent;
@@ -11,6 +13,7 @@ class UNiagaraSystem;
 /**
  * Simple tank shell - flies forward, explodes on hit.
  * Uses ProjectileMovementComponent for reliable physics-free movement.
+ * Shells are pooled by UProjectilePoolSubsystem: they are launched and parked, not spawned and destroyed.
  */
 UCLASS()
 class SANDBOX_API ATankProjectile : public AActor
@@ -20,13 +23,32 @@ class SANDBOX_API ATankProjectile : public AActor
 public:
 	ATankProjectile();
 
+	// Start a flight. ShotId is the latency tracking ID from UFireLatencySubsystem (0 = untracked).
+	void Launch(AActor* Shooter, const FVector& Location, const FRotator& Rotation, uint32 InShotId);
+
+	// Hide and stop ticking until the next Launch. The shell stays awake so the hide reaches
+	// clients; the pool makes it dormant once it has been parked for a while.
+	void Park();
+
+	// World time of the last Park
+	double GetParkTime() const { return ParkTime; }
+
+	// Flight model, for aim solving
+	float GetLaunchSpeed() const { return Speed; }
+	float GetLifeTime() const { return LifeTime; }
+	float GetGravityScale() const;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 
 private:
 	void Explode(const FVector& Location);
 
+	// Flight over - back to the pool (or destroyed if there is none)
+	void Retire();
+
 	UPROPERTY(VisibleAnywhere)
 	UStaticMeshComponent* Mesh;
 
@@ -51,4 +73,12 @@ private:
 
 	float Age = 0.f;
 	FVector PrevLocation;
+	uint32 ShotId = 0;
+	double ParkTime = 0.0;
+
+	// Ignores this shell and its shooter - built once per launch, shared by the hit trace and the blast overlap
+	FCollisionQueryParams QueryParams;
+
+	// Reused by every explosion of this shell so the overlap doesn't allocate once it has grown
+	TArray<FOverlapResult> OverlapScratch;
 };
@@ -13,17 +13,25 @@ public class Sandbox : ModuleRules
 			"InputCore",
 			"EnhancedInput",
 			"PhysicsCore",
-			"Niagara"
+			"Chaos",
+			"Niagara",
+			"AIModule",
+			"ProceduralMeshComponent",
+			"RenderCore",
+			"ReplicationGraph"
 		});
 
 		PublicIncludePaths.AddRange(new string[] {
 			"Sandbox",
 			"Sandbox/Pawns",
+			"Sandbox/AI",
 			"Sandbox/Components",
 			"Sandbox/Input",
 			"Sandbox/UI",
 			"Sandbox/Projectiles",
-			"Sandbox/Destructibles"
+			"Sandbox/Destructibles",
+			"Sandbox/Terrain",
+			"Sandbox/Systems"
 		});
 	}
 }
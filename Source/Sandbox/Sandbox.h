@@ -1,3 +1,31 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CoreGlobals.h"
+#include "Misc/App.h"
+
+namespace Sandbox
+{
+	// Nobody will see anything - server builds, a game binary run with -server,
+	// or a headless commandlet such as the batch match runner.
+	// Cosmetic work (VFX, decals, tread animation, material instances) is skipped.
+	inline bool IsCosmeticDisabled()
+	{
+#if UE_SERVER
+		return true;
+#else
+		return IsRunningDedicatedServer() || !FApp::CanEverRender();
+#endif
+	}
+
+	// Nobody will ever hear anything - dedicated servers only. Headless runs keep the
+	// voice bookkeeping (it doesn't need an audio device) so budgets can be checked there.
+	inline bool IsAudioDisabled()
+	{
+#if UE_SERVER
+		return true;
+#else
+		return IsRunningDedicatedServer();
+#endif
+	}
+}
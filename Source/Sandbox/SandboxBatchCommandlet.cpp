@@ -0,0 +1,290 @@
+#include "SandboxBatchCommandlet.h"
+#include "SandboxGameMode.h"
+#include "Pawns/TankPawn.h"
+#include "Pawns/TankBotPawn.h"
+#include "Systems/TankSpawnSubsystem.h"
+#include "AI/TankAIController.h"
+#include "Destructibles/WoodenCrate.h"
+#include "Destructibles/ExplosiveBarrel.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/Parse.h"
+#include "UObject/UObjectGlobals.h"
+
+USandboxBatchCommandlet::USandboxBatchCommandlet()
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 USandboxBatchCommandlet::Main(const FString& Params)
+{
+	int32 NumWorlds = 4;
+	int32 Seed = 1;
+	float SimSeconds = 120.f;
+	float Step = 1.f / 30.f;
+	FMatchSettings Settings;
+
+	FParse::Value(*Params, TEXT("Worlds="), NumWorlds);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Seconds="), SimSeconds);
+	FParse::Value(*Params, TEXT("Step="), Step);
+	FParse::Value(*Params, TEXT("Bots="), Settings.Bots);
+	FParse::Value(*Params, TEXT("Crates="), Settings.Crates);
+	FParse::Value(*Params, TEXT("Barrels="), Settings.Barrels);
+	FParse::Value(*Params, TEXT("Arena="), Settings.ArenaSize);
+
+	NumWorlds = FMath::Max(1, NumWorlds);
+	Step = FMath::Clamp(Step, 1.f / 240.f, 0.1f);
+
+	for (int32 i = 0; i < NumWorlds; i++)
+	{
+		UGameInstance* Match = CreateMatch(i);
+		if (!Match)
+		{
+			UE_LOG(LogTemp, Error, TEXT("SandboxBatch: failed to create match %d"), i);
+			continue;
+		}
+		PopulateMatch(Match->GetWorld(), Settings, Seed + i);
+	}
+	if (Matches.Num() == 0) return 1;
+
+	UE_LOG(LogTemp, Display, TEXT("SandboxBatch: %d matches, %d bots each, %.0fs at %.1f Hz"),
+		Matches.Num(), Settings.Bots, SimSeconds, 1.f / Step);
+
+	// Bots re-target about once a simulated second, GC every ten
+	const int32 NumSteps = FMath::CeilToInt(SimSeconds / Step);
+	const int32 GoalSteps = FMath::Max(1, FMath::RoundToInt(1.f / Step));
+	const int32 GCSteps = GoalSteps * 10;
+	constexpr double ReportInterval = 5.0;
+
+	TArray<double> WorldTickSeconds;
+	WorldTickSeconds.SetNumZeroed(Matches.Num());
+
+	const double StartTime = FPlatformTime::Seconds();
+	double LastReportTime = StartTime;
+	int32 LastReportStep = 0;
+	int32 StepIndex = 0;
+
+	// UWorld::Tick, spawning and the physics scene sync all require the game thread, so the matches
+	// are interleaved here. Within each step the work spreads across cores: Chaos solves on worker
+	// threads and the subsystems' ParallelFor jobs use the task graph.
+	for (; StepIndex < NumSteps && !IsEngineExitRequested(); StepIndex++)
+	{
+		GFrameCounter++;
+		FApp::SetDeltaTime(Step);
+		FApp::SetCurrentTime(FApp::GetCurrentTime() + Step);
+
+		for (int32 i = 0; i < Matches.Num(); i++)
+		{
+			UWorld* World = Matches[i]->GetWorld();
+			if (StepIndex % GoalSteps == 0)
+			{
+				UpdateBotGoals(World);
+			}
+
+			const double TickStart = FPlatformTime::Seconds();
+			TGuardValue<UWorldProxy, UWorld*> WorldGuard(GWorld, World);
+			World->Tick(LEVELTICK_All, Step);
+			WorldTickSeconds[i] += FPlatformTime::Seconds() - TickStart;
+		}
+
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		FTSTicker::GetCoreTicker().Tick(Step);
+
+		if (StepIndex % GCSteps == GCSteps - 1)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		if (Now - LastReportTime >= ReportInterval)
+		{
+			const double Simulated = (StepIndex + 1 - LastReportStep) * Step * Matches.Num();
+			UE_LOG(LogTemp, Display, TEXT("SandboxBatch: t=%.0fs  %.1f sim s / wall s"),
+				(StepIndex + 1) * Step, Simulated / (Now - LastReportTime));
+			LastReportTime = Now;
+			LastReportStep = StepIndex + 1;
+		}
+	}
+
+	const double WallSeconds = FMath::Max(FPlatformTime::Seconds() - StartTime, UE_SMALL_NUMBER);
+	const double SimulatedTotal = StepIndex * Step * Matches.Num();
+	UE_LOG(LogTemp, Display, TEXT("SandboxBatch: %.0f simulated seconds in %.1f wall seconds - %.1f sim s / wall s"),
+		SimulatedTotal, WallSeconds, SimulatedTotal / WallSeconds);
+	for (int32 i = 0; i < Matches.Num(); i++)
+	{
+		UE_LOG(LogTemp, Display, TEXT("  match %d: %.2f ms/step"), i, StepIndex > 0 ? WorldTickSeconds[i] * 1000.0 / StepIndex : 0.0);
+		if (DirectSpawnSeconds.IsValidIndex(i) && DirectSpawnCounts[i] > 0)
+		{
+			UE_LOG(LogTemp, Display, TEXT("  spawn before: %d ATankPawn direct in one frame - %.3f ms/tank, %.2f ms frame"),
+				DirectSpawnCounts[i], DirectSpawnSeconds[i] * 1000.0 / DirectSpawnCounts[i], DirectSpawnSeconds[i] * 1000.0);
+		}
+		if (const UTankSpawnSubsystem* Spawner = Matches[i]->GetWorld()->GetSubsystem<UTankSpawnSubsystem>())
+		{
+			UE_LOG(LogTemp, Display, TEXT("  spawn after:"));
+			Spawner->DumpToLog();
+		}
+	}
+
+	for (UGameInstance* Match : Matches)
+	{
+		DestroyMatch(Match);
+	}
+	Matches.Reset();
+	DirectSpawnSeconds.Reset();
+	DirectSpawnCounts.Reset();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+	return 0;
+}
+
+UGameInstance* USandboxBatchCommandlet::CreateMatch(int32 Index)
+{
+	// Standalone game instance - its own world context and empty world, no local players
+	UGameInstance* GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->InitializeStandalone(*FString::Printf(TEXT("SandboxBatch_%d"), Index));
+
+	UWorld* World = GameInstance->GetWorld();
+	if (!World)
+	{
+		GameInstance->Shutdown();
+		return nullptr;
+	}
+
+	const FURL URL(nullptr, *FString::Printf(TEXT("SandboxBatch_%d?game=%s"), Index, *ASandboxGameMode::StaticClass()->GetPathName()), TRAVEL_Absolute);
+	World->SetGameMode(URL);
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	Matches.Add(GameInstance);
+	return GameInstance;
+}
+
+void USandboxBatchCommandlet::PopulateMatch(UWorld* World, const FMatchSettings& Settings, int32 Seed)
+{
+	FRandomStream Random(Seed);
+	const float HalfArena = Settings.ArenaSize * 0.5f;
+
+	// Flat ground, top face at Z=0
+	if (AStaticMeshActor* Ground = World->SpawnActor<AStaticMeshActor>(FVector(0.f, 0.f, -50.f), FRotator::ZeroRotator))
+	{
+		UStaticMeshComponent* GroundMesh = Ground->GetStaticMeshComponent();
+		GroundMesh->SetMobility(EComponentMobility::Movable);
+		GroundMesh->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube")));
+		Ground->SetActorScale3D(FVector(Settings.ArenaSize / 100.f, Settings.ArenaSize / 100.f, 1.f));
+	}
+
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	// Bots start on a ring facing the middle, spawned over the first few steps
+	TArray<FTransform> BotTransforms;
+	BotTransforms.Reserve(Settings.Bots);
+	for (int32 i = 0; i < Settings.Bots; i++)
+	{
+		const float Angle = 2.f * PI * i / FMath::Max(1, Settings.Bots);
+		const FVector Location(FMath::Cos(Angle) * HalfArena * 0.7f, FMath::Sin(Angle) * HalfArena * 0.7f, 100.f);
+		BotTransforms.Emplace(FRotator(0.f, FMath::RadiansToDegrees(Angle) + 180.f, 0.f), Location);
+	}
+	DirectSpawnSeconds.Add(MeasureDirectSpawn(World, BotTransforms));
+	DirectSpawnCounts.Add(BotTransforms.Num());
+	if (UTankSpawnSubsystem* Spawner = World->GetSubsystem<UTankSpawnSubsystem>())
+	{
+		Spawner->SpawnTanks(ATankBotPawn::StaticClass(), BotTransforms);
+	}
+
+	auto RandomSpot = [&Random, HalfArena](float Z)
+	{
+		return FVector(Random.FRandRange(-0.5f, 0.5f) * HalfArena, Random.FRandRange(-0.5f, 0.5f) * HalfArena, Z);
+	};
+	for (int32 i = 0; i < Settings.Crates; i++)
+	{
+		World->SpawnActor<AWoodenCrate>(AWoodenCrate::StaticClass(), RandomSpot(60.f), FRotator(0.f, Random.FRandRange(0.f, 360.f), 0.f), Params);
+	}
+	for (int32 i = 0; i < Settings.Barrels; i++)
+	{
+		World->SpawnActor<AExplosiveBarrel>(AExplosiveBarrel::StaticClass(), RandomSpot(60.f), FRotator::ZeroRotator, Params);
+	}
+}
+
+double USandboxBatchCommandlet::MeasureDirectSpawn(UWorld* World, TArrayView<const FTransform> Transforms)
+{
+	FActorSpawnParameters Params;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	TArray<ATankPawn*> Tanks;
+	Tanks.Reserve(Transforms.Num());
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (const FTransform& Transform : Transforms)
+	{
+		if (ATankPawn* Tank = World->SpawnActor<ATankPawn>(ATankPawn::StaticClass(), Transform, Params))
+		{
+			Tank->SpawnDefaultController();
+			Tanks.Add(Tank);
+		}
+	}
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	// Only the cost was wanted - the match's bots come from the spawner
+	for (ATankPawn* Tank : Tanks)
+	{
+		if (AController* Controller = Tank->GetController())
+		{
+			Controller->Destroy();
+		}
+		Tank->Destroy();
+	}
+	return Elapsed;
+}
+
+void USandboxBatchCommandlet::UpdateBotGoals(UWorld* World)
+{
+	// No players to chase - each bot hunts the next one round the ring
+	TArray<ATankPawn*, TInlineAllocator<16>> Tanks;
+	for (TActorIterator<ATankPawn> It(World); It; ++It)
+	{
+		Tanks.Add(*It);
+	}
+	if (Tanks.Num() < 2) return;
+
+	for (int32 i = 0; i < Tanks.Num(); i++)
+	{
+		if (ATankAIController* AI = Cast<ATankAIController>(Tanks[i]->GetController()))
+		{
+			AI->SetGoalLocation(Tanks[(i + 1) % Tanks.Num()]->GetActorLocation());
+		}
+	}
+}
+
+void USandboxBatchCommandlet::DestroyMatch(UGameInstance* GameInstance)
+{
+	UWorld* World = GameInstance->GetWorld();
+	if (World)
+	{
+		World->BeginTearingDown();
+		for (FActorIterator It(World); It; ++It)
+		{
+			It->RouteEndPlay(EEndPlayReason::Quit);
+		}
+	}
+
+	GameInstance->Shutdown();
+
+	if (World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SandboxBatchCommandlet.generated.h"
+
+class UGameInstance;
+
+/**
+ * Runs several independent headless matches in one process for bot training and balance runs.
+ * Each match is its own game instance and world with its own ASandboxGameMode, AI tanks and
+ * destructibles, stepped with a fixed timestep. Throughput is reported as simulated seconds
+ * per wall second. The final report also compares each match's bot spawn cost through
+ * UTankSpawnSubsystem ("after") with spawning the same number of ATankPawns directly ("before").
+ *
+ *   UnrealEditor-Cmd Sandbox -run=SandboxBatch -Worlds=8 -Bots=6 -Crates=40 -Barrels=8 -Seconds=300 -Step=0.0333 -Seed=1
+ */
+UCLASS()
+class SANDBOX_API USandboxBatchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USandboxBatchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FMatchSettings
+	{
+		int32 Bots = 6;
+		int32 Crates = 40;
+		int32 Barrels = 8;
+		float ArenaSize = 12000.f;
+	};
+
+	UGameInstance* CreateMatch(int32 Index);
+	void PopulateMatch(UWorld* World, const FMatchSettings& Settings, int32 Seed);
+
+	// Old spawn path for comparison: the player tank class spawned and possessed in one frame,
+	// then destroyed. Returns the seconds it took.
+	double MeasureDirectSpawn(UWorld* World, TArrayView<const FTransform> Transforms);
+	void UpdateBotGoals(UWorld* World);
+	void DestroyMatch(UGameInstance* GameInstance);
+
+	UPROPERTY()
+	TArray<UGameInstance*> Matches;
+
+	// Per match, same order as Matches
+	TArray<double> DirectSpawnSeconds;
+	TArray<int32> DirectSpawnCounts;
+};
@@ -0,0 +1,108 @@
+#include "SandboxEventsCommandlet.h"
+#include "Systems/EventStreamSubsystem.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+USandboxEventsCommandlet::USandboxEventsCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+// Header fields; the write index is read as a plain value from a private copy
+static bool ReadStreamHeader(FArchive& Reader, FSandboxEventStreamHeader& OutHeader, uint64& OutWriteIndex)
+{
+	alignas(FSandboxEventStreamHeader) uint8 Raw[sizeof(FSandboxEventStreamHeader)];
+	Reader.Seek(0);
+	Reader.Serialize(Raw, sizeof(Raw));
+	if (Reader.IsError()) return false;
+
+	const FSandboxEventStreamHeader* Header = reinterpret_cast<const FSandboxEventStreamHeader*>(Raw);
+	OutHeader.Magic = Header->Magic;
+	OutHeader.Version = Header->Version;
+	OutHeader.RecordSize = Header->RecordSize;
+	OutHeader.Capacity = Header->Capacity;
+	OutWriteIndex = Header->WriteIndex.load(std::memory_order_relaxed);
+	return true;
+}
+
+int32 USandboxEventsCommandlet::Main(const FString& Params)
+{
+	FString InPath;
+	FString OutPath;
+	if (!FParse::Value(*Params, TEXT("In="), InPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SandboxEvents: usage -run=SandboxEvents -In=<capture.sbev> [-Out=<events.csv>]"));
+		return 1;
+	}
+	if (!FParse::Value(*Params, TEXT("Out="), OutPath))
+	{
+		OutPath = FPaths::ChangeExtension(InPath, TEXT("csv"));
+	}
+
+	// The game keeps the file mapped for writing while it runs
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*InPath, FILEREAD_AllowWrite));
+	if (!Reader)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SandboxEvents: can't open %s"), *InPath);
+		return 1;
+	}
+
+	FSandboxEventStreamHeader Header;
+	uint64 WriteIndex = 0;
+	if (!ReadStreamHeader(*Reader, Header, WriteIndex)
+		|| Header.Magic != FSandboxEventStreamHeader::ExpectedMagic
+		|| Header.Version != FSandboxEventStreamHeader::CurrentVersion
+		|| Header.RecordSize != sizeof(FSandboxEventRecord)
+		|| Header.Capacity == 0 || !FMath::IsPowerOfTwo(Header.Capacity)
+		|| Reader->TotalSize() < (int64)(sizeof(FSandboxEventStreamHeader) + (uint64)Header.Capacity * sizeof(FSandboxEventRecord)))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SandboxEvents: %s is not an event stream (or a different version)"), *InPath);
+		return 1;
+	}
+
+	TArray<FSandboxEventRecord> Records;
+	Records.SetNumUninitialized(Header.Capacity);
+	Reader->Seek(sizeof(FSandboxEventStreamHeader));
+	Reader->Serialize(Records.GetData(), (int64)Records.Num() * sizeof(FSandboxEventRecord));
+
+	// Anything the writer has lapped since the first header read may be torn
+	uint64 WriteIndexAfter = WriteIndex;
+	FSandboxEventStreamHeader HeaderAfter;
+	ReadStreamHeader(*Reader, HeaderAfter, WriteIndexAfter);
+	Reader.Reset();
+
+	const uint64 Capacity = Header.Capacity;
+	const uint64 First = WriteIndexAfter >= Capacity ? WriteIndexAfter - Capacity + 1 : 0;
+	const uint64 Oldest = WriteIndex > Capacity ? WriteIndex - Capacity : 0;
+
+	FString Csv = TEXT("Index,Time,Event,X,Y,Z,ShotId,ObjectId,Count,Depth");
+	Csv += LINE_TERMINATOR;
+
+	int64 NumWritten = 0;
+	for (uint64 Index = FMath::Max(First, Oldest); Index < WriteIndex; Index++)
+	{
+		const FSandboxEventRecord& Record = Records[Index & (Capacity - 1)];
+		Csv += FString::Printf(TEXT("%llu,%.4f,%s,%.1f,%.1f,%.1f,%u,%u,%u,%u"),
+			Index, Record.Time, UEventStreamSubsystem::GetEventName((ESandboxEvent)Record.Type),
+			Record.X, Record.Y, Record.Z, Record.ShotId, Record.ObjectId, (uint32)Record.Count, (uint32)Record.Depth);
+		Csv += LINE_TERMINATOR;
+		NumWritten++;
+	}
+
+	const int64 NumLost = (int64)Oldest;
+	const int64 NumTorn = (int64)(FMath::Max(First, Oldest) - Oldest);
+	if (!FFileHelper::SaveStringToFile(Csv, *OutPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SandboxEvents: failed to write %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("SandboxEvents: wrote %lld events to %s (%llu recorded, %lld overwritten in the ring, %lld dropped as torn)"),
+		NumWritten, *OutPath, WriteIndex, NumLost, NumTorn);
+	return 0;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SandboxEventsCommandlet.generated.h"
+
+/**
+ * Converts an event stream capture (Saved/Events/<World>.sbev) to CSV, oldest event first.
+ * The file is read as it stands, so a stream the game is still writing can be converted too;
+ * records the game may have overwritten mid-read are dropped.
+ *
+ *   UnrealEditor-Cmd Sandbox -run=SandboxEvents -In=Saved/Events/Arena.sbev [-Out=Arena.csv]
+ */
+UCLASS()
+class SANDBOX_API USandboxEventsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USandboxEventsCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -1,9 +1,26 @@
 #include "SandboxGameMode.h"
 #include "Pawns/TankPawn.h"
 #include "UI/TankHUD.h"
+#include "Sandbox.h"
+#include "Kismet/GameplayStatics.h"
 
 ASandboxGameMode::ASandboxGameMode()
 {
 	DefaultPawnClass = ATankPawn::StaticClass();
 	HUDClass = ATankHUD::StaticClass();
 }
+
+void ASandboxGameMode::StartPlay()
+{
+	Super::StartPlay();
+
+	if (Sandbox::IsCosmeticDisabled()) return;
+
+	// Player 0 already exists; each extra local player gets its own controller, pawn and HUD.
+	// Gamepads map to players in order (keyboard/mouse stays with player 0).
+	const int32 NumPlayers = FMath::Clamp(UGameplayStatics::GetIntOption(OptionsString, TEXT("Players"), DefaultLocalPlayers), 1, MaxLocalPlayers);
+	for (int32 i = GetWorld()->GetGameInstance()->GetNumLocalPlayers(); i < NumPlayers; i++)
+	{
+		UGameplayStatics::CreatePlayer(this, -1, true);
+	}
+}
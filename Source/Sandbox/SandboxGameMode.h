@@ -4,11 +4,23 @@
 #include "GameFramework/GameModeBase.h"
 #include "SandboxGameMode.generated.h"
 
-UCLASS()
+/**
+ * Up to four local tank players in splitscreen.
+ * Player count comes from the "?Players=N" URL option, else DefaultLocalPlayers.
+ */
+UCLASS(Config = Game)
 class SANDBOX_API ASandboxGameMode : public AGameModeBase
 {
 	GENERATED_BODY()
 
 public:
 	ASandboxGameMode();
+
+	virtual void StartPlay() override;
+
+private:
+	static constexpr int32 MaxLocalPlayers = 4;
+
+	UPROPERTY(Config)
+	int32 DefaultLocalPlayers = 1;
 };
@@ -0,0 +1,171 @@
+#include "SandboxReplicationGraph.h"
+#include "Pawns/TankPawn.h"
+#include "Projectiles/TankProjectile.h"
+#include "Destructibles/DestructibleTarget.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_CYCLE_STAT(TEXT("Sandbox ReplicateActors"), STAT_SandboxReplicateActors, STATGROUP_Game);
+
+static FAutoConsoleCommandWithWorldAndArgs CmdRepGraph(
+	TEXT("Sandbox.RepGraph"),
+	TEXT("Print replication pass time and bytes sent per connection. Args: [Reset]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UNetDriver* Driver = World ? World->GetNetDriver() : nullptr;
+		USandboxReplicationGraph* Graph = Driver ? Cast<USandboxReplicationGraph>(Driver->GetReplicationDriver()) : nullptr;
+		if (!Graph)
+		{
+			UE_LOG(LogTemp, Display, TEXT("RepGraph: not a server using USandboxReplicationGraph"));
+			return;
+		}
+
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("Reset"), ESearchCase::IgnoreCase))
+		{
+			Graph->ResetStats();
+			return;
+		}
+		Graph->DumpToLog();
+	}));
+
+USandboxReplicationGraph::ERoute USandboxReplicationGraph::GetRoute(const AActor* Actor)
+{
+	if (Actor->IsA<ATankPawn>()) return ERoute::Dynamic;
+	if (Actor->IsA<ADestructibleTarget>() || Actor->IsA<ATankProjectile>()) return ERoute::Dormancy;
+	return ERoute::Default;
+}
+
+void USandboxReplicationGraph::SetClassSettings(UClass* Class, float CullDistance, float UpdateFrequency)
+{
+	FClassReplicationInfo Info;
+	Info.SetCullDistanceSquared(CullDistance * CullDistance);
+	Info.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(UpdateFrequency);
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (It->IsChildOf(Class) && !It->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+		{
+			GlobalActorReplicationInfoMap.SetClassInfo(*It, Info);
+		}
+	}
+}
+
+void USandboxReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	SetClassSettings(ATankPawn::StaticClass(), TankCullDistance, TankUpdateFrequency);
+	SetClassSettings(ADestructibleTarget::StaticClass(), DestructibleCullDistance, DestructibleUpdateFrequency);
+	SetClassSettings(ATankProjectile::StaticClass(), ProjectileCullDistance, ProjectileUpdateFrequency);
+}
+
+void USandboxReplicationGraph::InitGlobalGraphNodes()
+{
+	Super::InitGlobalGraphNodes();
+
+	// The grid builds its cells lazily, so resizing before the first actor is added is enough
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = GridSpatialBias;
+}
+
+void USandboxReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	switch (GetRoute(ActorInfo.Actor))
+	{
+	case ERoute::Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case ERoute::Dormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	default:
+		Super::RouteAddNetworkActorToNodes(ActorInfo, GlobalInfo);
+		break;
+	}
+}
+
+void USandboxReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	switch (GetRoute(ActorInfo.Actor))
+	{
+	case ERoute::Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case ERoute::Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	default:
+		Super::RouteRemoveNetworkActorToNodes(ActorInfo);
+		break;
+	}
+}
+
+int32 USandboxReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_SandboxReplicateActors);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 Result = Super::ServerReplicateActors(DeltaSeconds);
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+	if (StatsStartTime == 0.0)
+	{
+		ResetStats();
+	}
+
+	NumFrames++;
+	NumConnectionFrames += NetDriver ? NetDriver->ClientConnections.Num() : 0;
+	TotalSeconds += Elapsed;
+	PeakSeconds = FMath::Max(PeakSeconds, Elapsed);
+
+	return Result;
+}
+
+void USandboxReplicationGraph::ResetStats()
+{
+	NumFrames = 0;
+	NumConnectionFrames = 0;
+	TotalSeconds = 0.0;
+	PeakSeconds = 0.0;
+	StatsStartTime = FPlatformTime::Seconds();
+
+	// Bytes are counted from here per connection
+	StartBytes.Reset();
+	if (NetDriver)
+	{
+		for (UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			if (Connection) StartBytes.Add(Connection, (int64)Connection->OutTotalBytes);
+		}
+	}
+}
+
+void USandboxReplicationGraph::DumpToLog() const
+{
+	const double Elapsed = FMath::Max(FPlatformTime::Seconds() - StatsStartTime, UE_SMALL_NUMBER);
+	const int32 NumConnections = NetDriver ? NetDriver->ClientConnections.Num() : 0;
+
+	// Only the whole pass is timed - the last figure is that time averaged over connections,
+	// not a measurement of any one connection
+	UE_LOG(LogTemp, Display, TEXT("RepGraph: %d connections, %lld frames in %.1fs - %.3f ms/frame (peak %.3f), %.3f ms pass time per connection (average share)"),
+		NumConnections, NumFrames, Elapsed,
+		NumFrames > 0 ? TotalSeconds * 1000.0 / NumFrames : 0.0, PeakSeconds * 1000.0,
+		NumConnectionFrames > 0 ? TotalSeconds * 1000.0 / NumConnectionFrames : 0.0);
+
+	if (!NetDriver) return;
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (!Connection) continue;
+
+		const int64* Start = StartBytes.Find(Connection);
+		const int64 Sent = (int64)Connection->OutTotalBytes - (Start ? *Start : 0);
+		UE_LOG(LogTemp, Display, TEXT("  %-24s %5d channels  %8.1f KB sent  %7.1f KB/s (now %.1f KB/s)"),
+			*Connection->LowLevelGetRemoteAddress(true), Connection->ActorChannelsNum(),
+			Sent / 1024.0, Sent / 1024.0 / Elapsed, Connection->OutBytesPerSecond / 1024.0);
+	}
+}
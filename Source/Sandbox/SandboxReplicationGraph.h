@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BasicReplicationGraph.h"
+#include "UObject/ObjectKey.h"
+#include "SandboxReplicationGraph.generated.h"
+
+/**
+ * Replication graph for many tanks and destructibles.
+ * Tanks are always-moving dynamic actors in the 2D spatial grid. Destructibles and shells are
+ * added by dormancy: intact objects and parked shells sit dormant in static cells and cost
+ * nothing until damaged or launched, while debris and shells in flight move to the dynamic
+ * cells. The game state and other bAlwaysRelevant actors go in the always-relevant node, and
+ * owner-only actors (player controllers) in per-connection nodes.
+ *
+ * Loopback check: run a listen or dedicated server, then connect local clients with
+ *   UnrealEditor Sandbox 127.0.0.1 -game -windowed -nosound
+ * and run Sandbox.RepGraph on the server for the replication pass time (whole pass, plus its
+ * average share per connection) and bytes sent per connection.
+ */
+UCLASS(Transient, Config = Engine)
+class SANDBOX_API USandboxReplicationGraph : public UBasicReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	void DumpToLog() const;
+	void ResetStats();
+
+private:
+	enum class ERoute : uint8
+	{
+		Default,     // UBasicReplicationGraph's routing
+		Dynamic,     // Spatialized, moves every frame
+		Dormancy     // Spatialized, static while dormant
+	};
+	static ERoute GetRoute(const AActor* Actor);
+
+	// Class and every loaded subclass (the base graph gave each replicated class its own entry)
+	void SetClassSettings(UClass* Class, float CullDistance, float UpdateFrequency);
+
+	// === CONFIG (DefaultEngine.ini) ===
+	UPROPERTY(Config)
+	float GridCellSize = 10000.f;
+
+	// World XY the grid starts from (cells below it are clamped into the first row/column)
+	UPROPERTY(Config)
+	FVector2D GridSpatialBias = FVector2D(-200000.f, -200000.f);
+
+	UPROPERTY(Config)
+	float TankCullDistance = 40000.f;
+
+	UPROPERTY(Config)
+	float TankUpdateFrequency = 30.f;
+
+	UPROPERTY(Config)
+	float DestructibleCullDistance = 20000.f;
+
+	UPROPERTY(Config)
+	float DestructibleUpdateFrequency = 10.f;
+
+	UPROPERTY(Config)
+	float ProjectileCullDistance = 30000.f;
+
+	UPROPERTY(Config)
+	float ProjectileUpdateFrequency = 30.f;
+
+	// Running totals for Sandbox.RepGraph
+	int64 NumFrames = 0;
+	int64 NumConnectionFrames = 0;  // Sum of connection counts over frames, for the average share
+	double TotalSeconds = 0.0;
+	double PeakSeconds = 0.0;
+	double StatsStartTime = 0.0;
+	TMap<TObjectKey<UNetConnection>, int64> StartBytes;
+};
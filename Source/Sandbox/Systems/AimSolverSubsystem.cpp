@@ -0,0 +1,276 @@
+#include "AimSolverSubsystem.h"
+#include "Projectiles/TankProjectile.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("AimSolver Solve"), STAT_AimSolverSolve, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("AimSolver Clearance"), STAT_AimSolverClearance, STATGROUP_Game);
+
+static FAutoConsoleCommandWithWorld CmdAimSolver(
+	TEXT("Sandbox.AimSolver"),
+	TEXT("Print batched aim solver stats"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UAimSolverSubsystem* Solver = World ? World->GetSubsystem<UAimSolverSubsystem>() : nullptr)
+		{
+			Solver->DumpToLog();
+		}
+	}));
+
+namespace
+{
+	// Streams in the lane buffer
+	enum ELane : int32
+	{
+		MuzzleX, MuzzleY, MuzzleZ,
+		TargetX, TargetY, TargetZ,
+		VelocityX, VelocityY, VelocityZ,
+		OutDeltaX, OutDeltaY, OutTan, OutTime, OutDisc,
+		NumLanes
+	};
+}
+
+bool UAimSolverSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UAimSolverSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAimSolverSubsystem, STATGROUP_Tickables);
+}
+
+void UAimSolverSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const ATankProjectile* Shell = GetDefault<ATankProjectile>();
+	ShellSpeed = Shell->GetLaunchSpeed();
+	ShellGravityScale = Shell->GetGravityScale();
+	ShellLifeTime = Shell->GetLifeTime();
+}
+
+void UAimSolverSubsystem::Deinitialize()
+{
+	Requests.Reset();
+	Solutions.Reset();
+	InFlight.Reset();
+	Lanes.Empty();
+	Super::Deinitialize();
+}
+
+void UAimSolverSubsystem::RequestAim(AActor* Gunner, const FVector& Muzzle, const FVector& Target, const FVector& TargetVelocity)
+{
+	FRequest& Request = Requests.AddDefaulted_GetRef();
+	Request.Gunner = Gunner;
+	Request.Muzzle = Muzzle;
+	Request.Target = Target;
+	Request.Velocity = TargetVelocity;
+}
+
+bool UAimSolverSubsystem::GetSolution(const AActor* Gunner, FAimSolution& OutSolution) const
+{
+	const FSolved* Solved = Solutions.Find(Gunner);
+	if (!Solved) return false;
+
+	OutSolution = Solved->Solution;
+	return true;
+}
+
+void UAimSolverSubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AimSolverClearance);
+		ResolveClearance(World);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AimSolverSolve);
+		SolveBatch();
+	}
+
+	// Gunners that stopped asking (dead, out of targets) drop out after a frame
+	for (auto It = Solutions.CreateIterator(); It; ++It)
+	{
+		if (It->Value.Frame + 1 < GFrameCounter) It.RemoveCurrent();
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AimSolverClearance);
+		IssueClearance(World);
+	}
+
+	Requests.Reset();
+}
+
+void UAimSolverSubsystem::SolveBatch()
+{
+	const int32 Num = Requests.Num();
+	if (Num == 0) return;
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 Padded = Align(Num, 4);
+
+	// Pad lanes repeat the last request so they solve to something harmless
+	Lanes.SetNumUninitialized(Padded * NumLanes, EAllowShrinking::No);
+	float* Stream[NumLanes];
+	for (int32 s = 0; s < NumLanes; s++)
+	{
+		Stream[s] = Lanes.GetData() + s * Padded;
+	}
+	for (int32 i = 0; i < Padded; i++)
+	{
+		const FRequest& Request = Requests[FMath::Min(i, Num - 1)];
+		Stream[MuzzleX][i] = Request.Muzzle.X;
+		Stream[MuzzleY][i] = Request.Muzzle.Y;
+		Stream[MuzzleZ][i] = Request.Muzzle.Z;
+		Stream[TargetX][i] = Request.Target.X;
+		Stream[TargetY][i] = Request.Target.Y;
+		Stream[TargetZ][i] = Request.Target.Z;
+		Stream[VelocityX][i] = Request.Velocity.X;
+		Stream[VelocityY][i] = Request.Velocity.Y;
+		Stream[VelocityZ][i] = Request.Velocity.Z;
+	}
+
+	// Low arc: tan(pitch) = (v^2 - sqrt(v^4 - g(g x^2 + 2 y v^2))) / (g x), flight time = x / (v cos(pitch))
+	const float Gravity = FMath::Max(-GetWorld()->GetGravityZ() * ShellGravityScale, UE_KINDA_SMALL_NUMBER);
+	const VectorRegister4Float G = VectorSetFloat1(Gravity);
+	const VectorRegister4Float V = VectorSetFloat1(ShellSpeed);
+	const VectorRegister4Float V2 = VectorSetFloat1(ShellSpeed * ShellSpeed);
+	const VectorRegister4Float V4 = VectorSetFloat1(ShellSpeed * ShellSpeed * ShellSpeed * ShellSpeed);
+	const VectorRegister4Float Two = VectorSetFloat1(2.f);
+	const VectorRegister4Float MinX = VectorSetFloat1(1.f);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const int32 Iterations = FMath::Max(1, LeadIterations);
+
+	for (int32 i = 0; i < Padded; i += 4)
+	{
+		const VectorRegister4Float Mx = VectorLoad(Stream[MuzzleX] + i);
+		const VectorRegister4Float My = VectorLoad(Stream[MuzzleY] + i);
+		const VectorRegister4Float Mz = VectorLoad(Stream[MuzzleZ] + i);
+		const VectorRegister4Float Tx = VectorLoad(Stream[TargetX] + i);
+		const VectorRegister4Float Ty = VectorLoad(Stream[TargetY] + i);
+		const VectorRegister4Float Tz = VectorLoad(Stream[TargetZ] + i);
+		const VectorRegister4Float Vx = VectorLoad(Stream[VelocityX] + i);
+		const VectorRegister4Float Vy = VectorLoad(Stream[VelocityY] + i);
+		const VectorRegister4Float Vz = VectorLoad(Stream[VelocityZ] + i);
+
+		// First pass aims at where the target is now, later passes lead it by the last flight time
+		VectorRegister4Float Time = Zero;
+		VectorRegister4Float Dx = Zero, Dy = Zero, Tan = Zero, Disc = Zero;
+		for (int32 Pass = 0; Pass < Iterations; Pass++)
+		{
+			Dx = VectorSubtract(VectorMultiplyAdd(Vx, Time, Tx), Mx);
+			Dy = VectorSubtract(VectorMultiplyAdd(Vy, Time, Ty), My);
+			const VectorRegister4Float Dz = VectorSubtract(VectorMultiplyAdd(Vz, Time, Tz), Mz);
+
+			const VectorRegister4Float X = VectorMax(VectorSqrt(VectorMultiplyAdd(Dx, Dx, VectorMultiply(Dy, Dy))), MinX);
+			const VectorRegister4Float GX2 = VectorMultiply(G, VectorMultiply(X, X));
+			Disc = VectorSubtract(V4, VectorMultiply(G, VectorMultiplyAdd(VectorMultiply(Two, Dz), V2, GX2)));
+
+			const VectorRegister4Float Root = VectorSqrt(VectorMax(Disc, Zero));
+			Tan = VectorDivide(VectorSubtract(V2, Root), VectorMultiply(G, X));
+
+			// 1 / cos = sqrt(1 + tan^2)
+			const VectorRegister4Float InvCos = VectorSqrt(VectorMultiplyAdd(Tan, Tan, VectorOneFloat()));
+			Time = VectorDivide(VectorMultiply(X, InvCos), V);
+		}
+
+		VectorStore(Dx, Stream[OutDeltaX] + i);
+		VectorStore(Dy, Stream[OutDeltaY] + i);
+		VectorStore(Tan, Stream[OutTan] + i);
+		VectorStore(Time, Stream[OutTime] + i);
+		VectorStore(Disc, Stream[OutDisc] + i);
+	}
+
+	for (int32 i = 0; i < Num; i++)
+	{
+		const AActor* Gunner = Requests[i].Gunner.Get();
+		if (!Gunner) continue;
+
+		FSolved& Solved = Solutions.FindOrAdd(Gunner);
+		FAimSolution& Solution = Solved.Solution;
+		Solution.Yaw = FMath::RadiansToDegrees(FMath::Atan2(Stream[OutDeltaY][i], Stream[OutDeltaX][i]));
+		Solution.Pitch = FMath::RadiansToDegrees(FMath::Atan(Stream[OutTan][i]));
+		Solution.FlightTime = Stream[OutTime][i];
+		Solution.bInRange = Stream[OutDisc][i] >= 0.f && Solution.FlightTime <= ShellLifeTime;
+		Solved.Frame = GFrameCounter;
+
+		NumInRange += Solution.bInRange ? 1 : 0;
+	}
+
+	NumSolved += Num;
+	SolveSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+void UAimSolverSubsystem::IssueClearance(UWorld* World)
+{
+	const FVector Gravity(0.f, 0.f, World->GetGravityZ() * ShellGravityScale);
+
+	for (const FRequest& Request : Requests)
+	{
+		AActor* Gunner = Request.Gunner.Get();
+		const FSolved* Solved = Gunner ? Solutions.Find(Gunner) : nullptr;
+		if (!Solved || !Solved->Solution.bInRange) continue;
+
+		// Two chords of the arc: muzzle to the midpoint of the flight, midpoint to the aim point
+		const FAimSolution& Solution = Solved->Solution;
+		const FVector Velocity = FRotator(Solution.Pitch, Solution.Yaw, 0.f).Vector() * ShellSpeed;
+		const float HalfTime = Solution.FlightTime * 0.5f;
+		const FVector Mid = Request.Muzzle + Velocity * HalfTime + 0.5f * Gravity * FMath::Square(HalfTime);
+		const FVector End = Request.Muzzle + Velocity * Solution.FlightTime + 0.5f * Gravity * FMath::Square(Solution.FlightTime);
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(AimSolver), false, Gunner);
+		FClearanceCheck& Check = InFlight.AddDefaulted_GetRef();
+		Check.Gunner = Gunner;
+		Check.AimPoint = End;
+		Check.Traces[0] = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Request.Muzzle, Mid, ECC_Visibility, Params);
+		Check.Traces[1] = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Mid, End, ECC_Visibility, Params);
+	}
+}
+
+void UAimSolverSubsystem::ResolveClearance(UWorld* World)
+{
+	const float RadiusSq = FMath::Square(ClearanceRadius);
+
+	FTraceDatum Datum;
+	for (const FClearanceCheck& Check : InFlight)
+	{
+		bool bClear = true;
+		for (const FTraceHandle& Trace : Check.Traces)
+		{
+			if (!Trace.IsValid() || !World->QueryTraceData(Trace, Datum)) continue;
+
+			for (const FHitResult& Hit : Datum.OutHits)
+			{
+				// Hitting something at the aim point is hitting the target
+				if (Hit.bBlockingHit && FVector::DistSquared(Hit.ImpactPoint, Check.AimPoint) > RadiusSq)
+				{
+					bClear = false;
+				}
+			}
+		}
+
+		if (FSolved* Solved = Solutions.Find(Check.Gunner))
+		{
+			Solved->Solution.bClear = bClear;
+		}
+		NumChecked++;
+		NumClear += bClear ? 1 : 0;
+	}
+	InFlight.Reset();
+}
+
+void UAimSolverSubsystem::DumpToLog() const
+{
+	UE_LOG(LogTemp, Display, TEXT("AimSolver: %d gunners, %lld solved (%.2f us each), %.0f%% in range, %.0f%% of checked arcs clear"),
+		Solutions.Num(), NumSolved, NumSolved > 0 ? SolveSeconds * 1e6 / NumSolved : 0.0,
+		NumSolved > 0 ? 100.0 * NumInRange / NumSolved : 0.0,
+		NumChecked > 0 ? 100.0 * NumClear / NumChecked : 0.0);
+	UE_LOG(LogTemp, Display, TEXT("  shell %.0f cm/s, gravity scale %.2f, %d lead passes"),
+		ShellSpeed, ShellGravityScale, LeadIterations);
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+#include "AimSolverSubsystem.generated.h"
+
+// Launch direction for one gunner, world space
+struct FAimSolution
+{
+	float Yaw = 0.f;
+	float Pitch = 0.f;        // Shell launch pitch, positive up
+	float FlightTime = 0.f;
+	bool bInRange = false;    // A low-arc solution exists within the shell's lifetime
+	bool bClear = false;      // The arc was unobstructed when last checked (a frame behind)
+};
+
+/**
+ * Main gun aiming for every bot at once.
+ * Gunners queue a request each frame (muzzle, target position and velocity). At the end of the
+ * frame the whole batch is solved four lanes at a time: closed-form low-arc pitch for the shell's
+ * speed and gravity, with the target's lead refined over a fixed number of flight-time passes.
+ * Each solved arc is then checked with two async line traces, resolved next frame.
+ *
+ * Console: Sandbox.AimSolver
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UAimSolverSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Queue for this frame's batch
+	void RequestAim(AActor* Gunner, const FVector& Muzzle, const FVector& Target, const FVector& TargetVelocity);
+
+	// Latest solution (from the previous frame's batch)
+	bool GetSolution(const AActor* Gunner, FAimSolution& OutSolution) const;
+
+	void DumpToLog() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FRequest
+	{
+		TWeakObjectPtr<AActor> Gunner;
+		FVector Muzzle = FVector::ZeroVector;
+		FVector Target = FVector::ZeroVector;
+		FVector Velocity = FVector::ZeroVector;
+	};
+
+	struct FSolved
+	{
+		FAimSolution Solution;
+		uint64 Frame = 0;
+	};
+
+	struct FClearanceCheck
+	{
+		TObjectKey<AActor> Gunner;
+		FVector AimPoint = FVector::ZeroVector;
+		FTraceHandle Traces[2];
+	};
+
+	void ResolveClearance(UWorld* World);
+	void SolveBatch();
+	void IssueClearance(UWorld* World);
+
+	// === CONFIG (DefaultGame.ini) ===
+	// Passes refining flight time and lead
+	UPROPERTY(Config)
+	int32 LeadIterations = 3;
+
+	// A blocking hit this close to the aim point counts as hitting the target
+	UPROPERTY(Config)
+	float ClearanceRadius = 350.f;
+
+	// Shell flight model, from the ATankProjectile defaults
+	float ShellSpeed = 8000.f;
+	float ShellGravityScale = 0.15f;
+	float ShellLifeTime = 5.f;
+
+	TArray<FRequest> Requests;
+	TMap<TObjectKey<AActor>, FSolved> Solutions;
+	TArray<FClearanceCheck> InFlight;
+
+	// Structure-of-arrays lanes for the batch, padded to a multiple of four
+	TArray<float> Lanes;
+
+	// Running totals for Sandbox.AimSolver
+	int64 NumSolved = 0;
+	int64 NumInRange = 0;
+	int64 NumChecked = 0;
+	int64 NumClear = 0;
+	double SolveSeconds = 0.0;
+};
@@ -0,0 +1,276 @@
+#include "AudioEventSubsystem.h"
+#include "Sandbox.h"
+#include "Components/AudioComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Sound/SoundBase.h"
+
+static FAutoConsoleCommandWithWorld CmdAudio(
+	TEXT("Sandbox.Audio"),
+	TEXT("Print active voices per category and merge/cull/drop counters"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UAudioEventSubsystem* Audio = World ? World->GetSubsystem<UAudioEventSubsystem>() : nullptr)
+		{
+			Audio->DumpToLog();
+		}
+	}));
+
+static const TCHAR* GetSoundName(ESandboxSound Sound)
+{
+	switch (Sound)
+	{
+	case ESandboxSound::Shot:      return TEXT("Shot");
+	case ESandboxSound::Explosion: return TEXT("Explosion");
+	case ESandboxSound::Break:     return TEXT("Break");
+	default:                       return TEXT("?");
+	}
+}
+
+bool UAudioEventSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UAudioEventSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	auto Load = [](const FSoftObjectPath& Path) -> USoundBase*
+	{
+		if (!Path.IsValid()) return nullptr;
+
+		USoundBase* Sound = Cast<USoundBase>(Path.TryLoad());
+		if (!Sound)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("AudioEvents: could not load %s - that event plays nothing"), *Path.ToString());
+		}
+		return Sound;
+	};
+
+	Sounds.SetNum((int32)ESandboxSound::Count);
+	Sounds[(int32)ESandboxSound::Shot] = Load(ShotSound);
+	Sounds[(int32)ESandboxSound::Explosion] = Load(ExplosionSound);
+	Sounds[(int32)ESandboxSound::Break] = Load(BreakSound);
+}
+
+void UAudioEventSubsystem::Deinitialize()
+{
+	if (PoolOwner)
+	{
+		PoolOwner->Destroy();
+		PoolOwner = nullptr;
+	}
+	FreeComponents.Reset();
+	Voices.Reset();
+	Pending.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UAudioEventSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAudioEventSubsystem, STATGROUP_Tickables);
+}
+
+void UAudioEventSubsystem::PostEvent(ESandboxSound Sound, const FVector& Location, float Loudness)
+{
+	// Nobody to hear it
+	if (Sandbox::IsAudioDisabled()) return;
+
+	FSoundEvent& Event = Pending.AddDefaulted_GetRef();
+	Event.Sound = Sound;
+	Event.Location = Location;
+	Event.Loudness = Loudness;
+}
+
+int32 UAudioEventSubsystem::GetMaxVoices(ESandboxSound Sound) const
+{
+	switch (Sound)
+	{
+	case ESandboxSound::Shot:      return MaxShotVoices;
+	case ESandboxSound::Explosion: return MaxExplosionVoices;
+	case ESandboxSound::Break:     return MaxBreakVoices;
+	default:                       return 0;
+	}
+}
+
+int32 UAudioEventSubsystem::GetActiveVoices(ESandboxSound Sound) const
+{
+	int32 Count = 0;
+	for (const FVoice& Voice : Voices)
+	{
+		Count += Voice.Sound == Sound;
+	}
+	return Count;
+}
+
+void UAudioEventSubsystem::Tick(float DeltaTime)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Retire finished voices by our own clock - the null device never reports completion
+	for (int32 i = Voices.Num() - 1; i >= 0; i--)
+	{
+		if (Voices[i].EndTime <= Now)
+		{
+			if (UAudioComponent* Component = Voices[i].Component)
+			{
+				Component->Stop();
+				FreeComponents.Add(Component);
+			}
+			Voices.RemoveAtSwap(i);
+		}
+	}
+
+	if (Pending.Num() == 0) return;
+
+	MergeExplosions();
+
+	TArray<FVector> Listeners;
+	GatherListeners(Listeners);
+
+	// Loudest first so the budget goes to what matters
+	Pending.Sort([](const FSoundEvent& A, const FSoundEvent& B) { return A.Loudness > B.Loudness; });
+
+	const float MaxDistSq = FMath::Square(MaxAudibleDistance);
+	for (const FSoundEvent& Event : Pending)
+	{
+		// No listeners (headless) means nothing to cull against
+		if (Listeners.Num() > 0 && !Listeners.ContainsByPredicate([&](const FVector& Listener)
+			{
+				return FVector::DistSquared(Listener, Event.Location) <= MaxDistSq;
+			}))
+		{
+			NumCulled++;
+			continue;
+		}
+
+		if (GetActiveVoices(Event.Sound) >= GetMaxVoices(Event.Sound))
+		{
+			// Steal the quietest voice in the category if this one is louder
+			int32 Quietest = INDEX_NONE;
+			for (int32 i = 0; i < Voices.Num(); i++)
+			{
+				if (Voices[i].Sound == Event.Sound && (Quietest == INDEX_NONE || Voices[i].Loudness < Voices[Quietest].Loudness))
+				{
+					Quietest = i;
+				}
+			}
+			if (Quietest == INDEX_NONE || Voices[Quietest].Loudness >= Event.Loudness)
+			{
+				NumDropped++;
+				continue;
+			}
+
+			if (UAudioComponent* Component = Voices[Quietest].Component)
+			{
+				Component->Stop();
+				FreeComponents.Add(Component);
+			}
+			Voices.RemoveAtSwap(Quietest);
+			NumDropped++;
+		}
+
+		StartVoice(Event, Now);
+	}
+	Pending.Reset();
+}
+
+void UAudioEventSubsystem::MergeExplosions()
+{
+	const float MergeDistSq = FMath::Square(MergeRadius);
+	for (int32 i = 0; i < Pending.Num(); i++)
+	{
+		if (Pending[i].Sound != ESandboxSound::Explosion) continue;
+
+		for (int32 j = Pending.Num() - 1; j > i; j--)
+		{
+			FSoundEvent& Into = Pending[i];
+			const FSoundEvent& Other = Pending[j];
+			if (Other.Sound != ESandboxSound::Explosion || FVector::DistSquared(Into.Location, Other.Location) > MergeDistSq) continue;
+
+			const float Total = Into.Loudness + Other.Loudness;
+			Into.Location = FMath::Lerp(Into.Location, Other.Location, Other.Loudness / Total);
+			Into.Loudness = FMath::Min(Total, MaxMergedLoudness);
+			Into.bMerged = true;
+			Pending.RemoveAtSwap(j);
+			NumMerged++;
+		}
+	}
+}
+
+void UAudioEventSubsystem::GatherListeners(TArray<FVector>& OutListeners) const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (PC && PC->IsLocalController())
+		{
+			FVector Location, Front, Right;
+			PC->GetAudioListenerPosition(Location, Front, Right);
+			OutListeners.Add(Location);
+		}
+	}
+}
+
+UAudioComponent* UAudioEventSubsystem::CreateVoiceComponent()
+{
+	if (!PoolOwner)
+	{
+		FActorSpawnParameters Params;
+		Params.ObjectFlags |= RF_Transient;
+		PoolOwner = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+		if (!PoolOwner) return nullptr;
+
+		USceneComponent* Root = NewObject<USceneComponent>(PoolOwner, TEXT("Root"));
+		PoolOwner->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	UAudioComponent* Component = NewObject<UAudioComponent>(PoolOwner);
+	Component->bAutoActivate = false;
+	Component->bAutoDestroy = false;
+	Component->SetupAttachment(PoolOwner->GetRootComponent());
+	Component->RegisterComponent();
+	return Component;
+}
+
+void UAudioEventSubsystem::StartVoice(const FSoundEvent& Event, double Now)
+{
+	USoundBase* Sound = Sounds[(int32)Event.Sound];
+
+	FVoice& Voice = Voices.AddDefaulted_GetRef();
+	Voice.Sound = Event.Sound;
+	Voice.Loudness = Event.Loudness;
+
+	const float Duration = Sound ? Sound->GetDuration() : 0.f;
+	Voice.EndTime = Now + (Duration > 0.f && Duration < INDEFINITELY_LOOPING_DURATION ? Duration : DefaultVoiceDuration);
+	NumPlayed++;
+
+	if (!Sound) return;
+
+	// Pool grows to the total voice budget, then components are reused
+	Voice.Component = FreeComponents.Num() > 0 ? FreeComponents.Pop(EAllowShrinking::No) : CreateVoiceComponent();
+	if (UAudioComponent* Component = Voice.Component)
+	{
+		Component->SetSound(Sound);
+		Component->SetWorldLocation(Event.Location);
+		Component->SetVolumeMultiplier(FMath::Min(Event.Loudness, MaxMergedLoudness));
+		// Merged blasts are a touch deeper, single ones play as authored
+		Component->SetPitchMultiplier(Event.bMerged ? FMath::Lerp(0.9f, 0.75f, FMath::Clamp(Event.Loudness - 1.f, 0.f, 1.f)) : 1.f);
+		Component->Play();
+	}
+}
+
+void UAudioEventSubsystem::DumpToLog() const
+{
+	UE_LOG(LogTemp, Display, TEXT("Audio events: played %d, merged %d, culled %d, dropped %d"),
+		NumPlayed, NumMerged, NumCulled, NumDropped);
+	for (int32 i = 0; i < (int32)ESandboxSound::Count; i++)
+	{
+		const ESandboxSound Sound = (ESandboxSound)i;
+		UE_LOG(LogTemp, Display, TEXT("  %-10s %d / %d voices"), GetSoundName(Sound), GetActiveVoices(Sound), GetMaxVoices(Sound));
+	}
+}
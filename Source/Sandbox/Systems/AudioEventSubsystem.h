@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AudioEventSubsystem.generated.h"
+
+class UAudioComponent;
+class USoundBase;
+
+enum class ESandboxSound : uint8
+{
+	Shot,
+	Explosion,
+	Break,
+	Count
+};
+
+/**
+ * Gameplay sound events with a fixed voice budget.
+ * Events are queued during the frame and resolved in Tick: explosions close together in
+ * the same frame merge into one louder voice, events beyond MaxAudibleDistance of every
+ * listener are culled, and each category is capped - a louder event steals the quietest
+ * voice, anything else is dropped. Voices play on a fixed pool of audio components.
+ *
+ * Voice bookkeeping doesn't depend on the audio device, so counts are the same under
+ * -nosound / the null device. Console: Sandbox.Audio
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UAudioEventSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Queue a sound for this frame. Loudness scales volume and voice priority.
+	void PostEvent(ESandboxSound Sound, const FVector& Location, float Loudness = 1.f);
+
+	int32 GetActiveVoices(ESandboxSound Sound) const;
+	int32 GetMaxVoices(ESandboxSound Sound) const;
+
+	// Lifetime counters
+	int32 GetNumPlayed() const { return NumPlayed; }
+	int32 GetNumMerged() const { return NumMerged; }
+	int32 GetNumCulled() const { return NumCulled; }
+	int32 GetNumDropped() const { return NumDropped; }
+
+	void DumpToLog() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FSoundEvent
+	{
+		ESandboxSound Sound = ESandboxSound::Shot;
+		FVector Location = FVector::ZeroVector;
+		float Loudness = 1.f;
+		bool bMerged = false;
+	};
+
+	struct FVoice
+	{
+		ESandboxSound Sound = ESandboxSound::Shot;
+		UAudioComponent* Component = nullptr;
+		float Loudness = 0.f;
+		double EndTime = 0.0;
+	};
+
+	void MergeExplosions();
+	void GatherListeners(TArray<FVector>& OutListeners) const;
+	void StartVoice(const FSoundEvent& Event, double Now);
+	UAudioComponent* CreateVoiceComponent();
+
+	// === CONFIG (DefaultGame.ini) ===
+	UPROPERTY(Config)
+	FSoftObjectPath ShotSound;
+
+	UPROPERTY(Config)
+	FSoftObjectPath ExplosionSound;
+
+	UPROPERTY(Config)
+	FSoftObjectPath BreakSound;
+
+	UPROPERTY(Config)
+	int32 MaxShotVoices = 6;
+
+	UPROPERTY(Config)
+	int32 MaxExplosionVoices = 4;
+
+	UPROPERTY(Config)
+	int32 MaxBreakVoices = 6;
+
+	UPROPERTY(Config)
+	float MaxAudibleDistance = 12000.f;
+
+	// Same-frame explosions closer than this become one voice
+	UPROPERTY(Config)
+	float MergeRadius = 600.f;
+
+	UPROPERTY(Config)
+	float MaxMergedLoudness = 2.5f;
+
+	// Used when a category has no sound asset (or it reports no duration)
+	UPROPERTY(Config)
+	float DefaultVoiceDuration = 1.5f;
+
+	// Indexed by ESandboxSound
+	UPROPERTY()
+	TArray<USoundBase*> Sounds;
+
+	// Owns the pooled audio components
+	UPROPERTY()
+	AActor* PoolOwner = nullptr;
+
+	UPROPERTY()
+	TArray<UAudioComponent*> FreeComponents;
+
+	// Components are owned by PoolOwner, which keeps them alive
+	TArray<FVoice> Voices;
+	TArray<FSoundEvent> Pending;
+
+	int32 NumPlayed = 0;
+	int32 NumMerged = 0;
+	int32 NumCulled = 0;
+	int32 NumDropped = 0;
+};
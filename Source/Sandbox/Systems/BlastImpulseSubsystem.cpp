@@ -0,0 +1,127 @@
+#include "BlastImpulseSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+#include "PBDRigidsSolver.h"
+
+DECLARE_CYCLE_STAT(TEXT("Blast Gather"), STAT_BlastGather, STATGROUP_Game);
+
+bool UBlastImpulseSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UBlastImpulseSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBlastImpulseSubsystem, STATGROUP_Tickables);
+}
+
+void UBlastImpulseSubsystem::AddBlast(const FVector& Location, float Radius, float Strength)
+{
+	if (Radius <= 0.f || Strength <= 0.f) return;
+
+	FBlast& Blast = Pending.AddDefaulted_GetRef();
+	Blast.Location = Location;
+	Blast.Radius = Radius;
+	Blast.Strength = Strength;
+}
+
+void UBlastImpulseSubsystem::Tick(float DeltaTime)
+{
+	if (Pending.Num() == 0) return;
+
+	UWorld* World = GetWorld();
+	FPhysScene* Scene = World->GetPhysicsScene();
+	Chaos::FPhysicsSolver* Solver = Scene ? Scene->GetSolver() : nullptr;
+	if (!Solver)
+	{
+		Pending.Reset();
+		return;
+	}
+
+	// Velocity change per body, summed over every blast this frame
+	TMap<Chaos::FSingleParticlePhysicsProxy*, FVector> Pushes;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_BlastGather);
+
+		FCollisionObjectQueryParams ObjectParams;
+		ObjectParams.AddObjectTypesToQuery(ECC_WorldDynamic);
+		ObjectParams.AddObjectTypesToQuery(ECC_PhysicsBody);
+		ObjectParams.AddObjectTypesToQuery(ECC_Pawn);
+		ObjectParams.AddObjectTypesToQuery(ECC_GameTraceChannel2);  // Debris
+
+		TArray<FOverlapResult> Overlaps;
+		TSet<const UPrimitiveComponent*> Seen;
+		for (const FBlast& Blast : Pending)
+		{
+			Overlaps.Reset();
+			Seen.Reset();
+			World->OverlapMultiByObjectType(Overlaps, Blast.Location, FQuat::Identity, ObjectParams,
+				FCollisionShape::MakeSphere(Blast.Radius), FCollisionQueryParams(SCENE_QUERY_STAT(BlastImpulse)));
+
+			for (const FOverlapResult& Overlap : Overlaps)
+			{
+				const UPrimitiveComponent* Component = Overlap.GetComponent();
+				if (!Component || !Component->IsSimulatingPhysics() || Seen.Contains(Component)) continue;
+				Seen.Add(Component);
+
+				const FBodyInstance* Body = Component->GetBodyInstance();
+				Chaos::FSingleParticlePhysicsProxy* Proxy = Body ? Body->GetPhysicsActor() : nullptr;
+				const float Mass = Body ? Body->GetBodyMass() : 0.f;
+				if (!Proxy || Mass <= KINDA_SMALL_NUMBER) continue;
+
+				const FVector Center = Component->Bounds.Origin;
+				const FVector Offset = Center - Blast.Location;
+				const float Falloff = 1.f - FMath::Clamp(Offset.Size() / Blast.Radius, 0.f, 1.f);
+				if (Falloff <= 0.f) continue;
+
+				const FVector Dir = (Offset.GetSafeNormal() + FVector::UpVector * UpwardBias).GetSafeNormal();
+				const FVector DeltaV = Dir * (BlastImpulse * Blast.Strength * Falloff / Mass);
+				Pushes.FindOrAdd(Proxy) += DeltaV;
+			}
+		}
+	}
+	Pending.Reset();
+
+	if (Pushes.Num() == 0) return;
+
+	TArray<TPair<Chaos::FSingleParticlePhysicsProxy*, FVector>> Batch;
+	Batch.Reserve(Pushes.Num());
+	for (const TPair<Chaos::FSingleParticlePhysicsProxy*, FVector>& Push : Pushes)
+	{
+		Batch.Emplace(Push.Key, Push.Value.GetClampedToMaxSize(MaxVelocityChange));
+	}
+
+	EnqueueVelocityChanges(World, MoveTemp(Batch));
+}
+
+void UBlastImpulseSubsystem::EnqueueVelocityChanges(UWorld* World, TArray<TPair<Chaos::FSingleParticlePhysicsProxy*, FVector>>&& Batch)
+{
+	FPhysScene* Scene = World ? World->GetPhysicsScene() : nullptr;
+	Chaos::FPhysicsSolver* Solver = Scene ? Scene->GetSolver() : nullptr;
+	if (!Solver || Batch.Num() == 0) return;
+
+	// One command for the whole batch, run on the physics thread before its next step
+	Solver->EnqueueCommandImmediate([Batch = MoveTemp(Batch)]()
+	{
+		for (const TPair<Chaos::FSingleParticlePhysicsProxy*, FVector>& Push : Batch)
+		{
+			Chaos::FSingleParticlePhysicsProxy* Proxy = Push.Key;
+			if (!Proxy || Proxy->GetMarkedDeleted()) continue;
+
+			Chaos::FRigidBodyHandle_Internal* Handle = Proxy->GetPhysicsThreadAPI();
+			if (!Handle) continue;
+
+			if (Handle->ObjectState() == Chaos::EObjectStateType::Sleeping)
+			{
+				Handle->SetObjectState(Chaos::EObjectStateType::Dynamic);
+			}
+			if (Handle->ObjectState() == Chaos::EObjectStateType::Dynamic)
+			{
+				Handle->SetV(Handle->V() + Push.Value);
+			}
+		}
+	});
+}
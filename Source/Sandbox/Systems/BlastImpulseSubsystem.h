@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BlastImpulseSubsystem.generated.h"
+
+namespace Chaos { class FSingleParticlePhysicsProxy; }
+
+/**
+ * Explosion push for simulating bodies.
+ * Blasts are queued during the frame; at the end of the frame every simulating body in
+ * range of any blast is found, impulses from all blasts are summed per body with a linear
+ * falloff, and the whole set is handed to the physics thread as one solver command that
+ * changes velocities directly - no per-component AddRadialImpulse on the game thread.
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UBlastImpulseSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Queue a push centered on Location (strength scales BlastImpulse)
+	void AddBlast(const FVector& Location, float Radius, float Strength = 1.f);
+
+	// Add velocity changes to dynamic (or sleeping) bodies in one physics thread command
+	static void EnqueueVelocityChanges(UWorld* World, TArray<TPair<Chaos::FSingleParticlePhysicsProxy*, FVector>>&& Batch);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FBlast
+	{
+		FVector Location = FVector::ZeroVector;
+		float Radius = 0.f;
+		float Strength = 1.f;
+	};
+
+	// === CONFIG (DefaultGame.ini) ===
+	// Impulse at the blast center (kg cm/s), divided by each body's mass
+	UPROPERTY(Config)
+	float BlastImpulse = 60000.f;
+
+	// Light bodies don't leave the map
+	UPROPERTY(Config)
+	float MaxVelocityChange = 2500.f;
+
+	// Extra upward share of the push
+	UPROPERTY(Config)
+	float UpwardBias = 0.3f;
+
+	TArray<FBlast> Pending;
+};
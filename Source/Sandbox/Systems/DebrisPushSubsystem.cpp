@@ -0,0 +1,222 @@
+#include "DebrisPushSubsystem.h"
+#include "BlastImpulseSubsystem.h"
+#include "Pawns/TankPawn.h"
+#include "Components/BoxComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+#include "PBDRigidsSolver.h"
+
+DECLARE_CYCLE_STAT(TEXT("Debris Push"), STAT_DebrisPush, STATGROUP_Game);
+
+static FAutoConsoleCommandWithWorld CmdDebrisPush(
+	TEXT("Sandbox.DebrisPush"),
+	TEXT("Print debris push field stats"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UDebrisPushSubsystem* Push = World ? World->GetSubsystem<UDebrisPushSubsystem>() : nullptr)
+		{
+			Push->DumpToLog();
+		}
+	}));
+
+bool UDebrisPushSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UDebrisPushSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDebrisPushSubsystem, STATGROUP_Tickables);
+}
+
+void UDebrisPushSubsystem::Deinitialize()
+{
+	Pushed.Reset();
+	Overlaps.Empty();
+	Super::Deinitialize();
+}
+
+void UDebrisPushSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_DebrisPush);
+
+	UWorld* World = GetWorld();
+
+	// Debris is simulated on the server and replicated - a client kick would just be corrected away
+	if (World->GetNetMode() == NM_Client) return;
+
+	const double Now = World->GetTimeSeconds();
+
+	FCollisionObjectQueryParams ObjectParams;
+	ObjectParams.AddObjectTypesToQuery(ECC_GameTraceChannel2);  // Debris
+
+	TMap<Chaos::FSingleParticlePhysicsProxy*, FVector> Kicks;
+	TArray<FProxyPair> NewIgnores;
+
+	for (TActorIterator<ATankPawn> It(World); It; ++It)
+	{
+		const UBoxComponent* Chassis = It->GetChassis();
+		if (!Chassis || !Chassis->IsSimulatingPhysics()) continue;
+
+		const FBodyInstance* ChassisBody = Chassis->GetBodyInstance();
+		Chaos::FSingleParticlePhysicsProxy* ChassisProxy = ChassisBody ? ChassisBody->GetPhysicsActor() : nullptr;
+		if (!ChassisProxy) continue;
+
+		const FTransform& Hull = Chassis->GetComponentTransform();
+		const FVector Forward = Hull.GetUnitAxis(EAxis::X);
+		const FVector Right = Hull.GetUnitAxis(EAxis::Y);
+		const FVector Velocity = Chassis->GetPhysicsLinearVelocity();
+
+		// Reversing pushes out of the back
+		const float ForwardSpeed = FVector::DotProduct(Velocity, Forward);
+		if (FMath::Abs(ForwardSpeed) < MinTankSpeed) continue;
+		const FVector Heading = ForwardSpeed > 0.f ? Forward : -Forward;
+		const float Speed = FMath::Abs(ForwardSpeed);
+
+		// Hull box stretched towards the heading, reaching further the faster the tank goes
+		const FVector Extent = Chassis->GetScaledBoxExtent();
+		const float Reach = Lookahead * FMath::Clamp(Speed / FMath::Max(It->GetMaxSpeed(), 1.f), 0.25f, 1.f);
+		const FVector FieldExtent(Extent.X + Reach * 0.5f, Extent.Y + SideMargin, Extent.Z + SideMargin);
+		const FVector FieldCenter = Hull.GetLocation() + Heading * (Reach * 0.5f);
+
+		Overlaps.Reset();
+		World->OverlapMultiByObjectType(Overlaps, FieldCenter, Hull.GetRotation(), ObjectParams,
+			FCollisionShape::MakeBox(FieldExtent), FCollisionQueryParams(SCENE_QUERY_STAT(DebrisPush)));
+
+		for (const FOverlapResult& Overlap : Overlaps)
+		{
+			UPrimitiveComponent* Component = Overlap.GetComponent();
+			if (!Component || !Component->IsSimulatingPhysics()) continue;
+
+			const FBodyInstance* Body = Component->GetBodyInstance();
+			Chaos::FSingleParticlePhysicsProxy* Proxy = Body ? Body->GetPhysicsActor() : nullptr;
+			if (!Proxy) continue;
+
+			if (Body->GetBodyMass() > MaxPushMass)
+			{
+				NumHeavySkipped++;
+				continue;
+			}
+
+			// Already kicked - keep it clear of the hull that pushed it while it stays in that field
+			if (FPushedPiece* Piece = Pushed.Find(Component))
+			{
+				if (Piece->Chassis == Chassis)
+				{
+					Piece->ExpireTime = Now + CollisionGrace;
+				}
+				continue;
+			}
+
+			FPushedPiece& Piece = Pushed.Add(Component);
+			Piece.Chassis = Chassis;
+			Piece.ExpireTime = Now + CollisionGrace;
+			NewIgnores.Emplace(Proxy, ChassisProxy);
+
+			// One kick on the way in, making up only what the piece lacks
+			const FVector PieceVelocity = Component->GetPhysicsLinearVelocity();
+			const FVector Offset = Component->Bounds.Origin - Hull.GetLocation();
+			const float Side = FVector::DotProduct(Offset, Right) >= 0.f ? 1.f : -1.f;
+
+			const float ForwardLack = Speed * ForwardSpeedScale - FVector::DotProduct(PieceVelocity, Heading);
+			const float SideLack = SideSpeed - FVector::DotProduct(PieceVelocity, Right) * Side;
+			const float LiftLack = LiftSpeed - PieceVelocity.Z;
+
+			const FVector DeltaV = Heading * FMath::Max(0.f, ForwardLack)
+				+ Right * (Side * FMath::Max(0.f, SideLack))
+				+ FVector::UpVector * FMath::Max(0.f, LiftLack);
+			if (!DeltaV.IsNearlyZero())
+			{
+				Kicks.FindOrAdd(Proxy) += DeltaV;
+			}
+		}
+	}
+
+	RestoreExpired(Now);
+	EnqueueIgnorePairs(World, MoveTemp(NewIgnores), true);
+
+	if (Kicks.Num() == 0) return;
+
+	TArray<TPair<Chaos::FSingleParticlePhysicsProxy*, FVector>> Batch;
+	Batch.Reserve(Kicks.Num());
+	for (const TPair<Chaos::FSingleParticlePhysicsProxy*, FVector>& Kick : Kicks)
+	{
+		Batch.Emplace(Kick.Key, Kick.Value.GetClampedToMaxSize(MaxVelocityChange));
+	}
+	NumKicks += Batch.Num();
+
+	UBlastImpulseSubsystem::EnqueueVelocityChanges(World, MoveTemp(Batch));
+}
+
+void UDebrisPushSubsystem::RestoreExpired(double Now)
+{
+	TArray<FProxyPair> Expired;
+	for (auto It = Pushed.CreateIterator(); It; ++It)
+	{
+		UPrimitiveComponent* Component = It->Key.Get();
+		if (!Component)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		if (It->Value.ExpireTime <= Now)
+		{
+			// Proxies are looked up again - either body may have been recreated or destroyed since
+			const FBodyInstance* Body = Component->GetBodyInstance();
+			const UPrimitiveComponent* Chassis = It->Value.Chassis.Get();
+			const FBodyInstance* ChassisBody = Chassis ? Chassis->GetBodyInstance() : nullptr;
+			if (Body && Body->GetPhysicsActor() && ChassisBody && ChassisBody->GetPhysicsActor())
+			{
+				Expired.Emplace(Body->GetPhysicsActor(), ChassisBody->GetPhysicsActor());
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	EnqueueIgnorePairs(GetWorld(), MoveTemp(Expired), false);
+}
+
+void UDebrisPushSubsystem::EnqueueIgnorePairs(UWorld* World, TArray<FProxyPair>&& Pairs, bool bIgnore)
+{
+	FPhysScene* Scene = World ? World->GetPhysicsScene() : nullptr;
+	Chaos::FPhysicsSolver* Solver = Scene ? Scene->GetSolver() : nullptr;
+	if (!Solver || Pairs.Num() == 0) return;
+
+	Solver->EnqueueCommandImmediate([Solver, Pairs = MoveTemp(Pairs), bIgnore]()
+	{
+		Chaos::FIgnoreCollisionManager& IgnoreManager = Solver->GetEvolution()->GetBroadPhase().GetIgnoreCollisionManager();
+		for (const FProxyPair& Pair : Pairs)
+		{
+			if (!Pair.Key || !Pair.Value || Pair.Key->GetMarkedDeleted() || Pair.Value->GetMarkedDeleted()) continue;
+
+			Chaos::FGeometryParticleHandle* Piece = Pair.Key->GetHandle_LowLevel();
+			Chaos::FGeometryParticleHandle* Hull = Pair.Value->GetHandle_LowLevel();
+			if (!Piece || !Hull) continue;
+
+			if (bIgnore)
+			{
+				// The broadphase only consults the manager for particles carrying this flag
+				if (Chaos::FPBDRigidParticleHandle* Rigid = Piece->CastToRigidParticle())
+				{
+					Rigid->AddCollisionConstraintFlag(Chaos::ECollisionConstraintFlags::CCF_BroadPhaseIgnoreCollisions);
+				}
+				IgnoreManager.AddIgnoreCollisions(Piece, Hull);
+			}
+			else
+			{
+				IgnoreManager.RemoveIgnoreCollisions(Piece, Hull);
+			}
+		}
+	});
+}
+
+void UDebrisPushSubsystem::DumpToLog() const
+{
+	UE_LOG(LogTemp, Display, TEXT("DebrisPush: %d pieces ignoring their pushing hull, %lld kicks, %lld heavy pieces left to contact"),
+		Pushed.Num(), NumKicks, NumHeavySkipped);
+}
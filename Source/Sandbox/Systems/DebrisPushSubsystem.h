@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/OverlapResult.h"
+#include "DebrisPushSubsystem.generated.h"
+
+class UPrimitiveComponent;
+namespace Chaos { class FSingleParticlePhysicsProxy; }
+
+/**
+ * Ploughs light debris out of the way of moving tanks instead of letting the chassis resolve
+ * contacts against every fragment. Each frame an oriented box around and ahead of each moving
+ * hull collects simulating debris; a piece up to MaxPushMass entering the box gets one velocity
+ * kick forward and to the side and stops colliding with that hull (other tanks still hit it)
+ * while it stays in the box. Kicks and collision changes go to the physics thread in batches.
+ * Heavier pieces keep full contact. Server (or standalone) only - clients get replicated debris.
+ *
+ * Console: Sandbox.DebrisPush
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UDebrisPushSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void DumpToLog() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	using FProxyPair = TPair<Chaos::FSingleParticlePhysicsProxy*, Chaos::FSingleParticlePhysicsProxy*>;
+
+	// Give pieces whose grace period ran out their contact with the pushing hull back
+	void RestoreExpired(double Now);
+
+	// Stop (or restart) contacts between each piece and hull in one physics thread command
+	static void EnqueueIgnorePairs(UWorld* World, TArray<FProxyPair>&& Pairs, bool bIgnore);
+
+	// === CONFIG (DefaultGame.ini) ===
+	// Tanks slower than this (cm/s) don't push
+	UPROPERTY(Config)
+	float MinTankSpeed = 150.f;
+
+	// How far ahead of the hull the field reaches, at full speed (cm)
+	UPROPERTY(Config)
+	float Lookahead = 400.f;
+
+	// Extra width either side of the hull (cm)
+	UPROPERTY(Config)
+	float SideMargin = 60.f;
+
+	// Heavier debris keeps full contact with the chassis (kg)
+	UPROPERTY(Config)
+	float MaxPushMass = 120.f;
+
+	// Pieces are driven to this fraction of the tank's forward speed...
+	UPROPERTY(Config)
+	float ForwardSpeedScale = 1.1f;
+
+	// ...moved off the tank's path at this speed...
+	UPROPERTY(Config)
+	float SideSpeed = 350.f;
+
+	// ...and lifted a little so they don't wedge under the hull
+	UPROPERTY(Config)
+	float LiftSpeed = 120.f;
+
+	UPROPERTY(Config)
+	float MaxVelocityChange = 1500.f;
+
+	// Seconds a piece keeps ignoring the hull after it last was in that hull's field
+	UPROPERTY(Config)
+	float CollisionGrace = 0.75f;
+
+	struct FPushedPiece
+	{
+		TWeakObjectPtr<const UPrimitiveComponent> Chassis;  // The hull it was kicked by and ignores
+		double ExpireTime = 0.0;
+	};
+	TMap<TWeakObjectPtr<UPrimitiveComponent>, FPushedPiece> Pushed;
+
+	// Reused each frame
+	TArray<FOverlapResult> Overlaps;
+
+	// Running totals for Sandbox.DebrisPush
+	int64 NumKicks = 0;
+	int64 NumHeavySkipped = 0;
+};
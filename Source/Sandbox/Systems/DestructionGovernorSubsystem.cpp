@@ -0,0 +1,180 @@
+#include "DestructionGovernorSubsystem.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "RenderCore.h"
+
+const float UDestructionGovernorSubsystem::DebrisScales[NumLevels] = { 1.f, 0.75f, 0.5f, 0.35f, 0.25f };
+const int32 UDestructionGovernorSubsystem::BreakDepthCuts[NumLevels] = { 0, 0, 1, 1, 2 };
+const float UDestructionGovernorSubsystem::EffectChances[NumLevels] = { 1.f, 0.8f, 0.6f, 0.4f, 0.2f };
+
+static FAutoConsoleCommandWithWorldAndArgs CmdGovernor(
+	TEXT("Sandbox.Governor"),
+	TEXT("Print destruction governor state. Args: <level> to pin a detail level, auto to release"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UDestructionGovernorSubsystem* Governor = World ? World->GetSubsystem<UDestructionGovernorSubsystem>() : nullptr;
+		if (!Governor) return;
+
+		if (Args.Num() > 0)
+		{
+			Governor->ForceLevel(Args[0] == TEXT("auto") ? INDEX_NONE : FCString::Atoi(*Args[0]));
+		}
+		Governor->DumpToLog();
+	}));
+
+void FGovernorPhysicsTick::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (!Governor) return;
+
+	if (bEnd)
+	{
+		Governor->MarkPhysicsEnd();
+	}
+	else
+	{
+		Governor->MarkPhysicsStart();
+	}
+}
+
+bool UDestructionGovernorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UDestructionGovernorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDestructionGovernorSubsystem, STATGROUP_Tickables);
+}
+
+void UDestructionGovernorSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Game thread reaches EndPhysics once the physics step is done, so the
+	// StartPhysics..EndPhysics window covers the step plus any wait on it.
+	// Sharing a tick group doesn't order ticks - each marker runs after the world's own
+	// start/end physics tick, so it brackets the step rather than racing it.
+	auto Register = [&InWorld, this](FGovernorPhysicsTick& Tick, ETickingGroup Group, bool bEnd, FTickFunction& After)
+	{
+		Tick.Governor = this;
+		Tick.bEnd = bEnd;
+		Tick.bCanEverTick = true;
+		Tick.bTickEvenWhenPaused = false;
+		Tick.TickGroup = Group;
+		Tick.EndTickGroup = Group;
+		Tick.RegisterTickFunction(InWorld.PersistentLevel);
+		Tick.AddPrerequisite(&InWorld, After);
+	};
+	Register(PhysicsStartTick, TG_StartPhysics, false, InWorld.StartPhysicsTickFunction);
+	Register(PhysicsEndTick, TG_EndPhysics, true, InWorld.EndPhysicsTickFunction);
+}
+
+void UDestructionGovernorSubsystem::Deinitialize()
+{
+	PhysicsStartTick.UnRegisterTickFunction();
+	PhysicsEndTick.UnRegisterTickFunction();
+	Super::Deinitialize();
+}
+
+void UDestructionGovernorSubsystem::MarkPhysicsStart()
+{
+	PhysicsStartCycles = FPlatformTime::Cycles64();
+}
+
+void UDestructionGovernorSubsystem::MarkPhysicsEnd()
+{
+	if (PhysicsStartCycles != 0)
+	{
+		LastPhysicsMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - PhysicsStartCycles);
+		PhysicsStartCycles = 0;
+	}
+}
+
+void UDestructionGovernorSubsystem::Tick(float DeltaTime)
+{
+	if (DeltaTime <= 0.f) return;
+
+	// GGameThreadTime is last frame's game thread work, excluding idle/wait
+	const double GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	const double Alpha = FMath::Clamp(DeltaTime / FMath::Max(SmoothingTime, KINDA_SMALL_NUMBER), 0.f, 1.f);
+	SmoothedGameThreadMs = FMath::Lerp(SmoothedGameThreadMs, GameThreadMs, Alpha);
+	SmoothedPhysicsMs = FMath::Lerp(SmoothedPhysicsMs, LastPhysicsMs, Alpha);
+
+	if (bForced) return;
+
+	const double Load = FMath::Max(SmoothedGameThreadMs / GameThreadBudgetMs, SmoothedPhysicsMs / PhysicsBudgetMs);
+
+	if (Load > DegradeLoad)
+	{
+		OverTime += DeltaTime;
+		UnderTime = 0.f;
+	}
+	else if (Load < RestoreLoad)
+	{
+		UnderTime += DeltaTime;
+		OverTime = 0.f;
+	}
+	else
+	{
+		// Dead band between the thresholds - hold the current level
+		OverTime = 0.f;
+		UnderTime = 0.f;
+	}
+
+	if (OverTime >= DegradeDelay && Level < NumLevels - 1)
+	{
+		SetLevel(Level + 1, TEXT("over budget"));
+	}
+	else if (UnderTime >= RestoreDelay && Level > 0)
+	{
+		SetLevel(Level - 1, TEXT("headroom"));
+	}
+}
+
+void UDestructionGovernorSubsystem::SetLevel(int32 NewLevel, const TCHAR* Reason)
+{
+	NewLevel = FMath::Clamp(NewLevel, 0, NumLevels - 1);
+	OverTime = 0.f;
+	UnderTime = 0.f;
+	if (NewLevel == Level) return;
+
+	UE_LOG(LogTemp, Display, TEXT("Destruction governor: level %d -> %d (%s; game %.2f/%.2f ms, physics %.2f/%.2f ms) debris x%.2f, depth -%d, vfx %.0f%%"),
+		Level, NewLevel, Reason, SmoothedGameThreadMs, GameThreadBudgetMs, SmoothedPhysicsMs, PhysicsBudgetMs,
+		DebrisScales[NewLevel], BreakDepthCuts[NewLevel], EffectChances[NewLevel] * 100.f);
+
+	Level = NewLevel;
+}
+
+void UDestructionGovernorSubsystem::ForceLevel(int32 NewLevel)
+{
+	bForced = NewLevel != INDEX_NONE;
+	if (bForced)
+	{
+		SetLevel(NewLevel, TEXT("forced"));
+	}
+}
+
+int32 UDestructionGovernorSubsystem::ScaleDebrisCount(int32 BaseCount) const
+{
+	return FMath::Max(1, FMath::RoundToInt(BaseCount * DebrisScales[Level]));
+}
+
+int32 UDestructionGovernorSubsystem::ScaleMaxBreakDepth(int32 BaseDepth) const
+{
+	// Always allow the first break so destruction stays readable
+	return FMath::Max(FMath::Min(BaseDepth, 1), BaseDepth - BreakDepthCuts[Level]);
+}
+
+bool UDestructionGovernorSubsystem::ShouldSpawnEffect() const
+{
+	return EffectChances[Level] >= 1.f || FMath::FRand() < EffectChances[Level];
+}
+
+void UDestructionGovernorSubsystem::DumpToLog() const
+{
+	UE_LOG(LogTemp, Display, TEXT("Destruction governor: level %d%s, game %.2f/%.2f ms, physics %.2f/%.2f ms"),
+		Level, bForced ? TEXT(" (forced)") : TEXT(""),
+		SmoothedGameThreadMs, GameThreadBudgetMs, SmoothedPhysicsMs, PhysicsBudgetMs);
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "DestructionGovernorSubsystem.generated.h"
+
+class UDestructionGovernorSubsystem;
+
+// Stamps the start/end of the physics window (StartPhysics..EndPhysics) each frame
+struct FGovernorPhysicsTick : public FTickFunction
+{
+	UDestructionGovernorSubsystem* Governor = nullptr;
+	bool bEnd = false;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+		const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override { return TEXT("FGovernorPhysicsTick"); }
+};
+
+/**
+ * Scales destruction detail to the machine.
+ * Smoothed game-thread time and physics-window time are compared against budgets each frame.
+ * Sustained overload steps the detail level down quickly; sustained headroom steps it back
+ * up slowly (hysteresis), and every step is logged. Destructibles read the current level
+ * for debris count, break depth and VFX spawn probability.
+ *
+ * Console: Sandbox.Governor [level | auto]
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UDestructionGovernorSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// 0 = full detail, NumLevels - 1 = minimum
+	int32 GetLevel() const { return Level; }
+
+	// Class values scaled for the current level
+	int32 ScaleDebrisCount(int32 BaseCount) const;
+	int32 ScaleMaxBreakDepth(int32 BaseDepth) const;
+
+	// Roll against the current VFX spawn probability
+	bool ShouldSpawnEffect() const;
+
+	// Pin a level (INDEX_NONE returns to automatic control)
+	void ForceLevel(int32 NewLevel);
+
+	void DumpToLog() const;
+
+	void MarkPhysicsStart();
+	void MarkPhysicsEnd();
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	void SetLevel(int32 NewLevel, const TCHAR* Reason);
+
+	static constexpr int32 NumLevels = 5;
+	static const float DebrisScales[NumLevels];
+	static const int32 BreakDepthCuts[NumLevels];
+	static const float EffectChances[NumLevels];
+
+	// === CONFIG (DefaultGame.ini) ===
+	UPROPERTY(Config)
+	float GameThreadBudgetMs = 12.f;
+
+	UPROPERTY(Config)
+	float PhysicsBudgetMs = 6.f;
+
+	// Load (time / budget) above this degrades, below RestoreLoad restores
+	UPROPERTY(Config)
+	float DegradeLoad = 1.f;
+
+	UPROPERTY(Config)
+	float RestoreLoad = 0.7f;
+
+	// Seconds the condition must hold before a step
+	UPROPERTY(Config)
+	float DegradeDelay = 0.5f;
+
+	UPROPERTY(Config)
+	float RestoreDelay = 3.f;
+
+	// Exponential smoothing time constant for the measurements
+	UPROPERTY(Config)
+	float SmoothingTime = 0.25f;
+
+	FGovernorPhysicsTick PhysicsStartTick;
+	FGovernorPhysicsTick PhysicsEndTick;
+	uint64 PhysicsStartCycles = 0;
+	double LastPhysicsMs = 0.0;
+
+	double SmoothedGameThreadMs = 0.0;
+	double SmoothedPhysicsMs = 0.0;
+	float OverTime = 0.f;
+	float UnderTime = 0.f;
+
+	int32 Level = 0;
+	bool bForced = false;
+};
@@ -0,0 +1,391 @@
+#include "DestructionStateSubsystem.h"
+#include "Destructibles/DestructibleTarget.h"
+#include "Destructibles/DestructibleField.h"
+#include "Destructibles/DebrisInstances.h"
+#include "Systems/HibernationSubsystem.h"
+#include "AI/FlowFieldSubsystem.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static FAutoConsoleCommandWithWorldAndArgs CmdSaveDestruction(
+	TEXT("Sandbox.Destruction.Save"),
+	TEXT("Save destruction state. Args: [Name]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UDestructionStateSubsystem* State = World ? World->GetSubsystem<UDestructionStateSubsystem>() : nullptr)
+		{
+			State->SaveSnapshot(UDestructionStateSubsystem::GetSnapshotPath(Args.Num() > 0 ? Args[0] : TEXT("Quick")));
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdLoadDestruction(
+	TEXT("Sandbox.Destruction.Load"),
+	TEXT("Restore destruction state. Args: [Name]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UDestructionStateSubsystem* State = World ? World->GetSubsystem<UDestructionStateSubsystem>() : nullptr)
+		{
+			State->LoadSnapshot(UDestructionStateSubsystem::GetSnapshotPath(Args.Num() > 0 ? Args[0] : TEXT("Quick")));
+		}
+	}));
+
+namespace
+{
+	constexpr float InvSqrt2 = 0.70710678f;
+}
+
+FString UDestructionStateSubsystem::GetSnapshotPath(const FString& Name)
+{
+	return FPaths::ProjectSavedDir() / TEXT("Destruction") / (Name + TEXT(".dstr"));
+}
+
+uint32 UDestructionStateSubsystem::PackRotation(const FQuat& Rotation)
+{
+	const FQuat Q = Rotation.GetNormalized();
+	const float C[4] = { (float)Q.X, (float)Q.Y, (float)Q.Z, (float)Q.W };
+
+	// Drop the largest component, it is rebuilt from the unit length
+	int32 Largest = 0;
+	for (int32 i = 1; i < 4; i++)
+	{
+		if (FMath::Abs(C[i]) > FMath::Abs(C[Largest])) Largest = i;
+	}
+	const float Sign = C[Largest] < 0.f ? -1.f : 1.f;
+
+	uint32 Packed = (uint32)Largest << 30;
+	int32 Shift = 20;
+	for (int32 i = 0; i < 4; i++)
+	{
+		if (i == Largest) continue;
+		const float Normalized = (C[i] * Sign / InvSqrt2) * 0.5f + 0.5f;
+		const uint32 Bits = (uint32)FMath::Clamp(FMath::RoundToInt(Normalized * 1023.f), 0, 1023);
+		Packed |= Bits << Shift;
+		Shift -= 10;
+	}
+	return Packed;
+}
+
+FQuat UDestructionStateSubsystem::UnpackRotation(uint32 Packed)
+{
+	const int32 Largest = Packed >> 30;
+	float C[4] = {};
+	float SumSq = 0.f;
+	int32 Shift = 20;
+	for (int32 i = 0; i < 4; i++)
+	{
+		if (i == Largest) continue;
+		const uint32 Bits = (Packed >> Shift) & 1023;
+		C[i] = ((float)Bits / 1023.f * 2.f - 1.f) * InvSqrt2;
+		SumSq += C[i] * C[i];
+		Shift -= 10;
+	}
+	C[Largest] = FMath::Sqrt(FMath::Max(0.f, 1.f - SumSq));
+	return FQuat(C[0], C[1], C[2], C[3]).GetNormalized();
+}
+
+bool UDestructionStateSubsystem::SaveSnapshot(const FString& Path)
+{
+	UWorld* World = GetWorld();
+	if (!World) return false;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Hibernated objects are only records - bring them back so they are saved like everything else
+	if (UHibernationSubsystem* Hibernation = World->GetSubsystem<UHibernationSubsystem>())
+	{
+		Hibernation->RestoreAll();
+	}
+
+	TArray<UClass*> Classes;
+	TMap<UClass*, uint16> ClassIndices;
+	TArray<FDestructionDamagedRecord> Damaged;
+	TArray<FDestructionDebrisRecord> Debris;
+
+	auto AddDebris = [&](UClass* Class, int32 Depth, const FTransform& Transform, const FLinearColor& Color)
+	{
+		uint16* ClassIndex = ClassIndices.Find(Class);
+		if (!ClassIndex)
+		{
+			ClassIndex = &ClassIndices.Add(Class, (uint16)Classes.Add(Class));
+		}
+
+		const FVector Pos = Transform.GetLocation() * DestructionFormat::PositionScale;
+
+		FDestructionDebrisRecord& Record = Debris.AddZeroed_GetRef();
+		Record.ClassIndex = *ClassIndex;
+		Record.Depth = (uint8)FMath::Clamp(Depth, 0, 255);
+		Record.Position[0] = FMath::RoundToInt32(Pos.X);
+		Record.Position[1] = FMath::RoundToInt32(Pos.Y);
+		Record.Position[2] = FMath::RoundToInt32(Pos.Z);
+		Record.Rotation = PackRotation(Transform.GetRotation());
+		Record.Color = Color.ToFColor(true);
+		Record.Scale = (uint16)FMath::Clamp(FMath::RoundToInt(Transform.GetScale3D().X * DestructionFormat::ScaleScale), 1, MAX_uint16);
+	};
+
+	for (TActorIterator<ADestructibleTarget> It(World); It; ++It)
+	{
+		ADestructibleTarget* Target = *It;
+		if (!IsValid(Target)) continue;
+
+		if (Target->GetPersistentId() != 0)
+		{
+			if (Target->GetCurrentHealth() < Target->GetMaxHealth())
+			{
+				Damaged.Add({ Target->GetPersistentId(), Target->GetCurrentHealth() });
+			}
+		}
+		else if (Target->GetBreakDepth() > 0)
+		{
+			AddDebris(Target->GetClass(), Target->GetBreakDepth(), Target->GetActorTransform(), Target->GetDebrisColor());
+		}
+	}
+
+	for (TActorIterator<ADebrisInstances> It(World); It; ++It)
+	{
+		It->ForEachPiece([&](TSubclassOf<ADestructibleTarget> Class, const FTransform& Transform)
+		{
+			const ADestructibleTarget* CDO = Class->GetDefaultObject<ADestructibleTarget>();
+			AddDebris(Class, CDO->GetMaxBreakDepth(), Transform, CDO->GetDebrisColor());
+		});
+	}
+
+	// Class table
+	TArray<uint8> ClassTable;
+	for (UClass* Class : Classes)
+	{
+		FTCHARToUTF8 Utf8(*Class->GetPathName());
+		const uint16 Length = (uint16)Utf8.Length();
+		ClassTable.Append(reinterpret_cast<const uint8*>(&Length), sizeof(Length));
+		ClassTable.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Length);
+	}
+	ClassTable.AddZeroed(Align(ClassTable.Num(), 4) - ClassTable.Num());
+
+	TArray<uint32> Destroyed = DestroyedIds.Array();
+
+	FDestructionFileHeader Header = {};
+	Header.Magic = DestructionFormat::Magic;
+	Header.Version = DestructionFormat::Version;
+	Header.HeaderSize = sizeof(FDestructionFileHeader);
+	Header.NumClasses = Classes.Num();
+	Header.ClassTableBytes = ClassTable.Num();
+	Header.NumDestroyed = Destroyed.Num();
+	Header.NumDamaged = Damaged.Num();
+	Header.NumDebris = Debris.Num();
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(sizeof(Header) + ClassTable.Num() + Destroyed.Num() * sizeof(uint32)
+		+ Damaged.Num() * sizeof(FDestructionDamagedRecord) + Debris.Num() * sizeof(FDestructionDebrisRecord));
+	Buffer.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	Buffer.Append(ClassTable);
+	Buffer.Append(reinterpret_cast<const uint8*>(Destroyed.GetData()), Destroyed.Num() * sizeof(uint32));
+	Buffer.Append(reinterpret_cast<const uint8*>(Damaged.GetData()), Damaged.Num() * sizeof(FDestructionDamagedRecord));
+	Buffer.Append(reinterpret_cast<const uint8*>(Debris.GetData()), Debris.Num() * sizeof(FDestructionDebrisRecord));
+
+	const bool bSaved = FFileHelper::SaveArrayToFile(Buffer, *Path);
+
+	UE_LOG(LogTemp, Display, TEXT("Destruction save %s: %d destroyed, %d damaged, %d debris, %d bytes in %.2f ms (%s)"),
+		bSaved ? TEXT("ok") : TEXT("FAILED"), Destroyed.Num(), Damaged.Num(), Debris.Num(), Buffer.Num(),
+		(FPlatformTime::Seconds() - StartTime) * 1000.0, *Path);
+
+	return bSaved;
+}
+
+bool UDestructionStateSubsystem::LoadSnapshot(const FString& Path)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	bool bRestored = false;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	FOpenMappedResult Mapped = PlatformFile.OpenMappedEx(*Path);
+
+	if (Mapped.HasValue())
+	{
+		TUniquePtr<IMappedFileHandle> Handle = Mapped.StealValue();
+		TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, Handle->GetFileSize()));
+		if (Region)
+		{
+			bRestored = RestoreFromMemory(Region->GetMappedPtr(), Region->GetMappedSize());
+		}
+		// Region must be released before its handle
+		Region.Reset();
+	}
+	else
+	{
+		// Platforms without mapping support
+		TArray<uint8> Data;
+		if (FFileHelper::LoadFileToArray(Data, *Path))
+		{
+			bRestored = RestoreFromMemory(Data.GetData(), Data.Num());
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Destruction load %s in %.2f ms (%s)"),
+		bRestored ? TEXT("ok") : TEXT("FAILED"), (FPlatformTime::Seconds() - StartTime) * 1000.0, *Path);
+
+	return bRestored;
+}
+
+bool UDestructionStateSubsystem::RestoreFromMemory(const uint8* Data, int64 Size)
+{
+	UWorld* World = GetWorld();
+	if (!World || !Data || Size < (int64)sizeof(FDestructionFileHeader)) return false;
+
+	FDestructionFileHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(Header));
+
+	if (Header.Magic != DestructionFormat::Magic || Header.Version != DestructionFormat::Version
+		|| Header.HeaderSize != sizeof(FDestructionFileHeader))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Destruction load: bad header (magic %08x, version %d)"), Header.Magic, Header.Version);
+		return false;
+	}
+
+	const int64 Expected = (int64)sizeof(Header) + Header.ClassTableBytes
+		+ (int64)Header.NumDestroyed * sizeof(uint32)
+		+ (int64)Header.NumDamaged * sizeof(FDestructionDamagedRecord)
+		+ (int64)Header.NumDebris * sizeof(FDestructionDebrisRecord);
+	if (Size < Expected || Header.ClassTableBytes % 4 != 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Destruction load: truncated file (%lld of %lld bytes)"), Size, Expected);
+		return false;
+	}
+
+	// === CLASS TABLE ===
+	TArray<UClass*> Classes;
+	Classes.Reserve(Header.NumClasses);
+	{
+		const uint8* Cursor = Data + sizeof(Header);
+		const uint8* End = Cursor + Header.ClassTableBytes;
+		for (uint32 i = 0; i < Header.NumClasses; i++)
+		{
+			uint16 Length = 0;
+			if (Cursor + sizeof(Length) > End) return false;
+			FMemory::Memcpy(&Length, Cursor, sizeof(Length));
+			Cursor += sizeof(Length);
+			if (Cursor + Length > End) return false;
+
+			const FString ClassPath(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Cursor), Length));
+			Classes.Add(FSoftClassPath(ClassPath).TryLoadClass<ADestructibleTarget>());
+			Cursor += Length;
+		}
+	}
+
+	// Sections are 4-byte aligned within the file, and the mapping itself is page aligned
+	const uint8* SectionStart = Data + sizeof(Header) + Header.ClassTableBytes;
+	const uint32* Destroyed = reinterpret_cast<const uint32*>(SectionStart);
+	const FDestructionDamagedRecord* Damaged = reinterpret_cast<const FDestructionDamagedRecord*>(Destroyed + Header.NumDestroyed);
+	const FDestructionDebrisRecord* Debris = reinterpret_cast<const FDestructionDebrisRecord*>(Damaged + Header.NumDamaged);
+
+	DestroyedIds.Reset();
+	DestroyedIds.Reserve(Header.NumDestroyed);
+	for (uint32 i = 0; i < Header.NumDestroyed; i++)
+	{
+		DestroyedIds.Add(Destroyed[i]);
+	}
+
+	TMap<uint32, float> DamagedHealth;
+	DamagedHealth.Reserve(Header.NumDamaged);
+	for (uint32 i = 0; i < Header.NumDamaged; i++)
+	{
+		DamagedHealth.Add(Damaged[i].PersistentId, Damaged[i].Health);
+	}
+
+	// === LEVEL OBJECTS ===
+	// Hibernated objects must be actors again for the destroyed/damaged pass to reach them
+	if (UHibernationSubsystem* Hibernation = World->GetSubsystem<UHibernationSubsystem>())
+	{
+		Hibernation->RestoreAll();
+	}
+
+	// Drop current debris so loading is idempotent, then apply destroyed/damaged state
+	for (TActorIterator<ADebrisInstances> It(World); It; ++It)
+	{
+		It->Destroy();
+	}
+
+	int32 NumRemoved = 0;
+	for (TActorIterator<ADestructibleTarget> It(World); It; ++It)
+	{
+		ADestructibleTarget* Target = *It;
+		if (!IsValid(Target)) continue;
+
+		const uint32 Id = Target->GetPersistentId();
+		if (Id == 0)
+		{
+			if (Target->GetBreakDepth() > 0) Target->Destroy();
+		}
+		else if (DestroyedIds.Contains(Id))
+		{
+			Target->Destroy();
+			NumRemoved++;
+		}
+		else if (const float* Health = DamagedHealth.Find(Id))
+		{
+			Target->SetCurrentHealth(*Health);
+		}
+	}
+
+	for (TActorIterator<ADestructibleField> It(World); It; ++It)
+	{
+		It->ApplyDestructionState(DestroyedIds, DamagedHealth);
+	}
+
+	// === DEBRIS ===
+	// Final-depth pieces can't break again, so they go into instances (in the class color); the rest become actors
+	TMap<UClass*, TArray<FTransform>> InstancedDebris;
+	int32 NumDebrisActors = 0;
+
+	for (uint32 i = 0; i < Header.NumDebris; i++)
+	{
+		const FDestructionDebrisRecord& Record = Debris[i];
+		UClass* Class = Classes.IsValidIndex(Record.ClassIndex) ? Classes[Record.ClassIndex] : nullptr;
+		if (!Class) continue;
+
+		const FTransform Transform(
+			UnpackRotation(Record.Rotation),
+			FVector(Record.Position[0], Record.Position[1], Record.Position[2]) / DestructionFormat::PositionScale,
+			FVector(Record.Scale / DestructionFormat::ScaleScale));
+		const FLinearColor Color(Record.Color);
+
+		if (Record.Depth >= Class->GetDefaultObject<ADestructibleTarget>()->GetMaxBreakDepth())
+		{
+			InstancedDebris.FindOrAdd(Class).Add(Transform);
+			continue;
+		}
+
+		ADestructibleTarget* Piece = World->SpawnActorDeferred<ADestructibleTarget>(
+			Class, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (Piece)
+		{
+			Piece->RestoreDebrisState(Record.Depth, Color);
+			Piece->FinishSpawning(Transform);
+			NumDebrisActors++;
+		}
+	}
+
+	int32 NumInstanced = 0;
+	if (InstancedDebris.Num() > 0)
+	{
+		ADebrisInstances* Rubble = World->SpawnActor<ADebrisInstances>();
+		for (const TPair<UClass*, TArray<FTransform>>& Pair : InstancedDebris)
+		{
+			Rubble->AddPieces(Pair.Key, Pair.Value);
+			NumInstanced += Pair.Value.Num();
+		}
+	}
+
+	if (UFlowFieldSubsystem* FlowFields = World->GetSubsystem<UFlowFieldSubsystem>())
+	{
+		FlowFields->NotifyObstaclesChanged();
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Destruction load: %d destroyed (%d actors removed), %d damaged, %d debris actors, %d instanced"),
+		DestroyedIds.Num(), NumRemoved, DamagedHealth.Num(), NumDebrisActors, NumInstanced);
+
+	return true;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DestructionStateSubsystem.generated.h"
+
+/**
+ * Destruction snapshot file layout (little endian, 4-byte aligned):
+ *
+ *   FDestructionFileHeader
+ *   Class table      NumClasses x [uint16 Length][UTF-8 class path], padded to 4 bytes
+ *   Destroyed IDs    uint32[NumDestroyed]
+ *   Damaged health   FDestructionDamagedRecord[NumDamaged]
+ *   Debris           FDestructionDebrisRecord[NumDebris]
+ */
+namespace DestructionFormat
+{
+	static constexpr uint32 Magic = 0x52545344;  // "DSTR"
+	static constexpr uint16 Version = 1;
+
+	// Position quantization - 0.25 cm steps
+	static constexpr float PositionScale = 4.f;
+	// Uniform scale quantization - 0.001 steps
+	static constexpr float ScaleScale = 1000.f;
+}
+
+struct FDestructionFileHeader
+{
+	uint32 Magic;
+	uint16 Version;
+	uint16 HeaderSize;
+	uint32 NumClasses;
+	uint32 ClassTableBytes;
+	uint32 NumDestroyed;
+	uint32 NumDamaged;
+	uint32 NumDebris;
+	uint32 Reserved;
+};
+static_assert(sizeof(FDestructionFileHeader) == 32, "Destruction header layout changed");
+
+struct FDestructionDamagedRecord
+{
+	uint32 PersistentId;
+	float Health;
+};
+static_assert(sizeof(FDestructionDamagedRecord) == 8, "Damaged record layout changed");
+
+struct FDestructionDebrisRecord
+{
+	uint16 ClassIndex;
+	uint8 Depth;
+	uint8 Flags;
+	int32 Position[3];   // Quantized by PositionScale
+	uint32 Rotation;     // Smallest-three quaternion, 2 + 3x10 bits
+	FColor Color;        // sRGB
+	uint16 Scale;        // Quantized by ScaleScale
+	uint16 Padding;
+};
+static_assert(sizeof(FDestructionDebrisRecord) == 28, "Debris record layout changed");
+
+/**
+ * Saves and restores battle damage - destroyed level objects, damaged health and
+ * surviving debris - as a packed binary snapshot. Loading memory-maps the file and
+ * restores in bulk; final-depth debris is restored into ADebrisInstances.
+ *
+ * Console: Sandbox.Destruction.Save [Name], Sandbox.Destruction.Load [Name]
+ */
+UCLASS()
+class SANDBOX_API UDestructionStateSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Called by ADestructibleTarget when an object with a persistent ID breaks
+	void NotifyDestroyed(uint32 PersistentId) { DestroyedIds.Add(PersistentId); }
+
+	bool SaveSnapshot(const FString& Path);
+	bool LoadSnapshot(const FString& Path);
+
+	static FString GetSnapshotPath(const FString& Name);
+
+	// Smallest-three quaternion, 2 + 3x10 bits (also used by UHibernationSubsystem)
+	static uint32 PackRotation(const FQuat& Rotation);
+	static FQuat UnpackRotation(uint32 Packed);
+
+private:
+	// Restore from an in-memory (usually mapped) snapshot
+	bool RestoreFromMemory(const uint8* Data, int64 Size);
+
+	TSet<uint32> DestroyedIds;
+};
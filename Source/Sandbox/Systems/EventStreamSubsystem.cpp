@@ -0,0 +1,206 @@
+#include "EventStreamSubsystem.h"
+#include "Destructibles/DestructibleTarget.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include "Windows/WindowsHWrapper.h"
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+static FAutoConsoleCommandWithWorld CmdEventStream(
+	TEXT("Sandbox.EventStream"),
+	TEXT("Print event stream file and per-event counts"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UEventStreamSubsystem* Events = World ? World->GetSubsystem<UEventStreamSubsystem>() : nullptr)
+		{
+			Events->DumpToLog();
+		}
+		else
+		{
+			UE_LOG(LogTemp, Display, TEXT("EventStream: off (enable with -EventStream)"));
+		}
+	}));
+
+bool UEventStreamSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UEventStreamSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer)) return false;
+	return bEnabled || FParse::Param(FCommandLine::Get(), TEXT("EventStream"));
+}
+
+void UEventStreamSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (!OpenStream())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("EventStream: could not map %s - events are not recorded"), *Path);
+		return;
+	}
+
+	ActorDestroyedHandle = GetWorld()->AddOnActorDestroyedHandler(
+		FOnActorDestroyed::FDelegate::CreateUObject(this, &UEventStreamSubsystem::HandleActorDestroyed));
+	UE_LOG(LogTemp, Display, TEXT("EventStream: recording to %s (%u records)"), *Path, IndexMask + 1);
+}
+
+void UEventStreamSubsystem::Deinitialize()
+{
+	if (ActorDestroyedHandle.IsValid())
+	{
+		GetWorld()->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+		ActorDestroyedHandle.Reset();
+	}
+	CloseStream();
+	Super::Deinitialize();
+}
+
+bool UEventStreamSubsystem::OpenStream()
+{
+	const uint32 Capacity = FMath::RoundUpToPowerOfTwo((uint32)FMath::Clamp(RecordCapacity, 1024, 1 << 24));
+	const SIZE_T Size = sizeof(FSandboxEventStreamHeader) + (SIZE_T)Capacity * sizeof(FSandboxEventRecord);
+
+	const FString Dir = FPaths::ProjectSavedDir() / TEXT("Events");
+	IFileManager::Get().MakeDirectory(*Dir, true);
+	Path = FPaths::ConvertRelativePathToFull(Dir / (GetWorld()->GetName() + TEXT(".sbev")));
+
+	// Readers may open the file while we hold it
+#if PLATFORM_WINDOWS
+	HANDLE File = CreateFileW(*Path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (File == INVALID_HANDLE_VALUE) return false;
+
+	HANDLE Mapping = CreateFileMappingW(File, nullptr, PAGE_READWRITE, (DWORD)((uint64)Size >> 32), (DWORD)(Size & 0xFFFFFFFF), nullptr);
+	CloseHandle(File);
+	if (!Mapping) return false;
+
+	void* View = MapViewOfFile(Mapping, FILE_MAP_ALL_ACCESS, 0, 0, Size);
+	CloseHandle(Mapping);
+	if (!View) return false;
+#else
+	const int Fd = open(TCHAR_TO_UTF8(*Path), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (Fd < 0) return false;
+	if (ftruncate(Fd, (off_t)Size) != 0)
+	{
+		close(Fd);
+		return false;
+	}
+
+	void* View = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, Fd, 0);
+	close(Fd);
+	if (View == MAP_FAILED) return false;
+#endif
+
+	MappedView = View;
+	MappedSize = Size;
+
+	Header = new (View) FSandboxEventStreamHeader();
+	Header->Version = FSandboxEventStreamHeader::CurrentVersion;
+	Header->RecordSize = sizeof(FSandboxEventRecord);
+	Header->Capacity = Capacity;
+	Header->WriteIndex.store(0, std::memory_order_relaxed);
+
+	// Magic last, so a reader that sees it sees the rest of the header
+	std::atomic_thread_fence(std::memory_order_release);
+	Header->Magic = FSandboxEventStreamHeader::ExpectedMagic;
+
+	Records = reinterpret_cast<FSandboxEventRecord*>(static_cast<uint8*>(View) + sizeof(FSandboxEventStreamHeader));
+	IndexMask = Capacity - 1;
+	NextIndex = 0;
+	return true;
+}
+
+void UEventStreamSubsystem::CloseStream()
+{
+	if (!MappedView) return;
+
+	// Dirty pages reach the file whether or not anyone still has it open
+#if PLATFORM_WINDOWS
+	UnmapViewOfFile(MappedView);
+#else
+	munmap(MappedView, MappedSize);
+#endif
+
+	MappedView = nullptr;
+	MappedSize = 0;
+	Header = nullptr;
+	Records = nullptr;
+}
+
+void UEventStreamSubsystem::Record(ESandboxEvent Type, const FVector& Location, const AActor* Object, uint32 ShotId, int32 Count, int32 Depth)
+{
+	if (!Records) return;
+	checkSlow(IsInGameThread());
+
+	// Seqlock writer: the slot's old record may still be being copied by a reader that checks
+	// WriteIndex afterwards. This fence keeps the new record's stores from becoming visible
+	// before the previous WriteIndex store (release alone only orders what comes before it).
+	std::atomic_thread_fence(std::memory_order_release);
+
+	FSandboxEventRecord& Out = Records[NextIndex & IndexMask];
+	Out.Time = GetWorld()->GetTimeSeconds();
+	Out.X = (float)Location.X;
+	Out.Y = (float)Location.Y;
+	Out.Z = (float)Location.Z;
+	Out.ShotId = ShotId;
+	Out.ObjectId = Object ? Object->GetUniqueID() : 0;
+	Out.Count = (uint16)FMath::Clamp(Count, 0, (int32)MAX_uint16);
+	Out.Type = (uint8)Type;
+	Out.Depth = (uint8)FMath::Clamp(Depth, 0, (int32)MAX_uint8);
+
+	// Publish - the record is complete before a reader can see the new index
+	Header->WriteIndex.store(++NextIndex, std::memory_order_release);
+	NumByType[(int32)Type]++;
+}
+
+void UEventStreamSubsystem::HandleActorDestroyed(AActor* Actor)
+{
+	if (!Actor) return;
+
+	const ADestructibleTarget* Destructible = Cast<ADestructibleTarget>(Actor);
+	Record(ESandboxEvent::Destroyed, Actor->GetActorLocation(), Actor, 0, 0, Destructible ? Destructible->GetBreakDepth() : 0);
+}
+
+const TCHAR* UEventStreamSubsystem::GetEventName(ESandboxEvent Type)
+{
+	switch (Type)
+	{
+	case ESandboxEvent::Fire: return TEXT("Fire");
+	case ESandboxEvent::Hit: return TEXT("Hit");
+	case ESandboxEvent::Explode: return TEXT("Explode");
+	case ESandboxEvent::Break: return TEXT("Break");
+	case ESandboxEvent::Destroyed: return TEXT("Destroyed");
+	default: return TEXT("Unknown");
+	}
+}
+
+void UEventStreamSubsystem::DumpToLog() const
+{
+	if (!Records)
+	{
+		UE_LOG(LogTemp, Display, TEXT("EventStream: not recording (%s could not be mapped)"), *Path);
+		return;
+	}
+
+	const uint64 Capacity = (uint64)IndexMask + 1;
+	UE_LOG(LogTemp, Display, TEXT("EventStream: %s - %llu written, %llu in ring of %llu"),
+		*Path, NextIndex, FMath::Min(NextIndex, Capacity), Capacity);
+	for (int32 TypeIndex = 0; TypeIndex < (int32)ESandboxEvent::Count; TypeIndex++)
+	{
+		UE_LOG(LogTemp, Display, TEXT("  %-10s %lld"), GetEventName((ESandboxEvent)TypeIndex), NumByType[TypeIndex]);
+	}
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include <atomic>
+#include "EventStreamSubsystem.generated.h"
+
+// Gameplay events in the stream
+enum class ESandboxEvent : uint8
+{
+	Fire,       // Tank fired a shell (at the muzzle)
+	Hit,        // Shell's trace hit something
+	Explode,    // Shell or barrel exploded; Count = actors a shell damaged (0 for barrels)
+	Break,      // Destructible broke; Depth = its break depth, Count = debris pieces spawned
+	Destroyed,  // Any actor destroyed
+	Count
+};
+
+// One event - fixed size, little-endian, as it sits in the file
+struct FSandboxEventRecord
+{
+	double Time;        // World seconds
+	float X, Y, Z;      // Where it happened
+	uint32 ShotId;      // Fire latency shot ID, 0 if not from a shell
+	uint32 ObjectId;    // UObject unique ID of the shooter, hit, exploding, broken or destroyed actor
+	uint16 Count;
+	uint8 Type;         // ESandboxEvent
+	uint8 Depth;
+};
+static_assert(sizeof(FSandboxEventRecord) == 32, "Event records are read by other processes - keep the layout");
+
+/**
+ * Start of a stream file; Capacity records follow.
+ * The game is the only writer. It issues a release fence, fills slot (Index & (Capacity - 1))
+ * and then publishes WriteIndex = Index + 1 with release order, overwriting the oldest record
+ * once full (the seqlock writer pattern - the fence keeps the slot stores behind the previous
+ * publish). A reader tails it without locks:
+ *   1. W = WriteIndex (acquire). Records max(Cursor, W - Capacity) .. W-1 are published.
+ *   2. Copy record i from its slot.
+ *   3. Acquire fence, then re-read WriteIndex. If it is now Capacity or more past i, the writer
+ *      may have reused the slot mid-copy - drop it, the reader has fallen behind.
+ */
+struct alignas(64) FSandboxEventStreamHeader
+{
+	static constexpr uint32 ExpectedMagic = 0x56454253;  // "SBEV"
+	static constexpr uint32 CurrentVersion = 1;
+
+	uint32 Magic;
+	uint32 Version;
+	uint32 RecordSize;
+	uint32 Capacity;    // Power of two
+
+	// Own cache line - it is the only field written after creation
+	alignas(64) std::atomic<uint64> WriteIndex;
+};
+static_assert(sizeof(FSandboxEventStreamHeader) == 128, "Event stream header is read by other processes - keep the layout");
+static_assert(std::atomic<uint64>::is_always_lock_free, "The write index is shared across processes");
+
+/**
+ * Gameplay event stream for offline and live destruction analysis.
+ * Events go as fixed-size records into a ring buffer in a memory-mapped file
+ * (Saved/Events/<World>.sbev), so an external process on the same machine can tail it while
+ * the game runs. Writing a record is a copy and one atomic store on the game thread - no
+ * locks, syscalls or allocation. Convert a capture with -run=SandboxEvents.
+ *
+ * Enabled by bEnabled in DefaultGame.ini or -EventStream on the command line; otherwise the
+ * subsystem isn't created.
+ *
+ * Console: Sandbox.EventStream
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UEventStreamSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Append an event (game thread only)
+	void Record(ESandboxEvent Type, const FVector& Location, const AActor* Object, uint32 ShotId = 0, int32 Count = 0, int32 Depth = 0);
+
+	const FString& GetPath() const { return Path; }
+
+	static const TCHAR* GetEventName(ESandboxEvent Type);
+
+	void DumpToLog() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	bool OpenStream();
+	void CloseStream();
+	void HandleActorDestroyed(AActor* Actor);
+
+	// === CONFIG (DefaultGame.ini) ===
+	UPROPERTY(Config)
+	bool bEnabled = false;
+
+	// Records in the ring, rounded up to a power of two (32 bytes each)
+	UPROPERTY(Config)
+	int32 RecordCapacity = 65536;
+
+	FString Path;
+	FSandboxEventStreamHeader* Header = nullptr;
+	FSandboxEventRecord* Records = nullptr;
+	uint64 NextIndex = 0;
+	uint32 IndexMask = 0;
+
+	// The file is closed once mapped; the view keeps it alive
+	void* MappedView = nullptr;
+	SIZE_T MappedSize = 0;
+
+	FDelegateHandle ActorDestroyedHandle;
+
+	// Running totals for Sandbox.EventStream
+	int64 NumByType[(int32)ESandboxEvent::Count] = {};
+};
@@ -0,0 +1,171 @@
+#include "FireLatencySubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static FAutoConsoleCommandWithWorldAndArgs CmdFireLatency(
+	TEXT("Sandbox.FireLatency"),
+	TEXT("Print per-stage fire latency percentiles. Args: reset | csv"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UFireLatencySubsystem* Latency = World ? World->GetSubsystem<UFireLatencySubsystem>() : nullptr;
+		if (!Latency) return;
+
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			Latency->Reset();
+		}
+		else if (Args.Num() > 0 && Args[0] == TEXT("csv"))
+		{
+			Latency->ExportCsv();
+		}
+		else
+		{
+			Latency->DumpToLog();
+		}
+	}));
+
+void UFireLatencySubsystem::Deinitialize()
+{
+	// Session end - keep whatever we measured
+	ExportCsv();
+	Super::Deinitialize();
+}
+
+uint32 UFireLatencySubsystem::BeginShot()
+{
+	FShotRecord& Record = InFlight.Add(NextShotId);
+	Record.ShotId = NextShotId;
+	Record.Cycles[(int32)EFireStage::Input] = FPlatformTime::Cycles64();
+	return NextShotId++;
+}
+
+void UFireLatencySubsystem::MarkStage(uint32 ShotId, EFireStage Stage)
+{
+	if (FShotRecord* Record = InFlight.Find(ShotId))
+	{
+		uint64& Stamp = Record->Cycles[(int32)Stage];
+		if (Stamp == 0)
+		{
+			Stamp = FPlatformTime::Cycles64();
+		}
+	}
+}
+
+void UFireLatencySubsystem::EndShot(uint32 ShotId)
+{
+	FShotRecord Record;
+	if (!InFlight.RemoveAndCopyValue(ShotId, Record)) return;
+
+	if (Completed.Num() < MaxCompleted)
+	{
+		Completed.Add(Record);
+	}
+	else
+	{
+		Completed[NextCompleted] = Record;
+		NextCompleted = (NextCompleted + 1) % MaxCompleted;
+	}
+}
+
+void UFireLatencySubsystem::CancelShot(uint32 ShotId)
+{
+	InFlight.Remove(ShotId);
+}
+
+void UFireLatencySubsystem::Reset()
+{
+	InFlight.Reset();
+	Completed.Reset();
+	NextCompleted = 0;
+}
+
+double UFireLatencySubsystem::GetStageMs(const FShotRecord& Record, EFireStage Stage)
+{
+	const uint64 Start = Record.Cycles[(int32)EFireStage::Input];
+	const uint64 Stamp = Record.Cycles[(int32)Stage];
+	if (Start == 0 || Stamp == 0) return -1.0;
+	return FPlatformTime::ToMilliseconds64(Stamp - Start);
+}
+
+const TCHAR* UFireLatencySubsystem::GetStageName(EFireStage Stage)
+{
+	switch (Stage)
+	{
+	case EFireStage::Input:     return TEXT("Input");
+	case EFireStage::Fire:      return TEXT("Fire");
+	case EFireStage::Spawn:     return TEXT("Spawn");
+	case EFireStage::FirstTick: return TEXT("FirstTick");
+	case EFireStage::Hit:       return TEXT("Hit");
+	case EFireStage::Damage:    return TEXT("Damage");
+	case EFireStage::Effects:   return TEXT("Effects");
+	default:                    return TEXT("Unknown");
+	}
+}
+
+void UFireLatencySubsystem::DumpToLog() const
+{
+	UE_LOG(LogTemp, Display, TEXT("Fire latency over %d shots (ms since input):"), Completed.Num());
+
+	TArray<double> Samples;
+	Samples.Reserve(Completed.Num());
+
+	for (int32 StageIndex = (int32)EFireStage::Fire; StageIndex < (int32)EFireStage::Count; StageIndex++)
+	{
+		const EFireStage Stage = (EFireStage)StageIndex;
+
+		Samples.Reset();
+		for (const FShotRecord& Record : Completed)
+		{
+			const double Ms = GetStageMs(Record, Stage);
+			if (Ms >= 0.0) Samples.Add(Ms);
+		}
+
+		if (Samples.Num() == 0)
+		{
+			UE_LOG(LogTemp, Display, TEXT("  %-10s  no samples"), GetStageName(Stage));
+			continue;
+		}
+
+		Samples.Sort();
+		auto Percentile = [&Samples](double P)
+		{
+			return Samples[FMath::Clamp(FMath::CeilToInt(P * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+		};
+
+		UE_LOG(LogTemp, Display, TEXT("  %-10s  n=%5d  p50=%8.3f  p95=%8.3f  p99=%8.3f  max=%8.3f"),
+			GetStageName(Stage), Samples.Num(), Percentile(0.5), Percentile(0.95), Percentile(0.99), Samples.Last());
+	}
+}
+
+bool UFireLatencySubsystem::ExportCsv() const
+{
+	if (Completed.Num() == 0) return false;
+
+	FString Csv = TEXT("ShotId");
+	for (int32 StageIndex = (int32)EFireStage::Fire; StageIndex < (int32)EFireStage::Count; StageIndex++)
+	{
+		Csv += FString::Printf(TEXT(",%sMs"), GetStageName((EFireStage)StageIndex));
+	}
+	Csv += LINE_TERMINATOR;
+
+	for (const FShotRecord& Record : Completed)
+	{
+		Csv += FString::Printf(TEXT("%u"), Record.ShotId);
+		for (int32 StageIndex = (int32)EFireStage::Fire; StageIndex < (int32)EFireStage::Count; StageIndex++)
+		{
+			const double Ms = GetStageMs(Record, (EFireStage)StageIndex);
+			Csv += Ms >= 0.0 ? FString::Printf(TEXT(",%.4f"), Ms) : FString(TEXT(","));
+		}
+		Csv += LINE_TERMINATOR;
+	}
+
+	const FString Path = FPaths::ProfilingDir() / TEXT("FireLatency") /
+		FString::Printf(TEXT("FireLatency-%s.csv"), *FDateTime::Now().ToString());
+
+	const bool bSaved = FFileHelper::SaveStringToFile(Csv, *Path);
+	UE_LOG(LogTemp, Display, TEXT("Fire latency: %s %d shots to %s"),
+		bSaved ? TEXT("wrote") : TEXT("failed to write"), Completed.Num(), *Path);
+	return bSaved;
+}
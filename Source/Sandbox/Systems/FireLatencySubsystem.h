@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FireLatencySubsystem.generated.h"
+
+// Stages of a shot, in the order they normally happen
+enum class EFireStage : uint8
+{
+	Input,      // FireAction Started reached HandleFire
+	Fire,       // Cooldown passed, Fire() entered
+	Spawn,      // Projectile actor spawned
+	FirstTick,  // Projectile's first Tick
+	Hit,        // Trace hit something
+	Damage,     // Explode applied damage
+	Effects,    // Explode spawned VFX
+	Count
+};
+
+/**
+ * Click-to-world latency tracker.
+ * Each shot gets an ID and a high-resolution cycle stamp per stage.
+ * "Sandbox.FireLatency" prints p50/p95/p99 per stage, CSV is written when the world ends.
+ */
+UCLASS()
+class SANDBOX_API UFireLatencySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Start a shot at the Input stage, returns its ID
+	uint32 BeginShot();
+
+	// Stamp a stage (first stamp wins, unknown IDs are ignored)
+	void MarkStage(uint32 ShotId, EFireStage Stage);
+
+	// Shot is over (exploded, expired or cancelled)
+	void EndShot(uint32 ShotId);
+
+	// Drop a shot that never left the barrel (e.g. on cooldown)
+	void CancelShot(uint32 ShotId);
+
+	void DumpToLog() const;
+	bool ExportCsv() const;
+	void Reset();
+
+	static const TCHAR* GetStageName(EFireStage Stage);
+
+private:
+	struct FShotRecord
+	{
+		uint32 ShotId = 0;
+		uint64 Cycles[(int32)EFireStage::Count] = {};
+	};
+
+	// Latency from Input to Stage in ms, or negative if the stage wasn't reached
+	static double GetStageMs(const FShotRecord& Record, EFireStage Stage);
+
+	TMap<uint32, FShotRecord> InFlight;
+
+	// Completed shots, oldest overwritten once full
+	TArray<FShotRecord> Completed;
+	int32 NextCompleted = 0;
+	static constexpr int32 MaxCompleted = 8192;
+
+	uint32 NextShotId = 1;
+};
@@ -0,0 +1,359 @@
+#include "FireSpreadSubsystem.h"
+#include "Sandbox.h"
+#include "Destructibles/DestructibleTarget.h"
+#include "Destructibles/DestructibleField.h"
+#include "Async/ParallelFor.h"
+#include "Engine/DamageEvents.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "NiagaraComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Fire Spread"), STAT_FireSpread, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Fire Damage"), STAT_FireDamage, STATGROUP_Game);
+
+static FAutoConsoleCommandWithWorld CmdFire(
+	TEXT("Sandbox.Fire"),
+	TEXT("Print fire grid cell and burning counts"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UFireSpreadSubsystem* Fire = World ? World->GetSubsystem<UFireSpreadSubsystem>() : nullptr)
+		{
+			Fire->DumpToLog();
+		}
+	}));
+
+// 8-neighbourhood; diagonals are further away so transfer less heat
+static const FIntPoint NeighbourOffsets[8] = {
+	{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+	{ 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 }
+};
+static constexpr float DiagonalHeatScale = 0.7f;
+
+bool UFireSpreadSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFireSpreadSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFireSpreadSubsystem, STATGROUP_Tickables);
+}
+
+void UFireSpreadSubsystem::Deinitialize()
+{
+	Cells.Reset();
+	CellLookup.Reset();
+	Burning.Reset();
+	Warm.Reset();
+	Effects.Reset();
+	Super::Deinitialize();
+}
+
+FIntPoint UFireSpreadSubsystem::ToCoord(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+int32 UFireSpreadSubsystem::FindOrAddCell(const FVector& Location)
+{
+	const FIntPoint Coord = ToCoord(Location);
+	if (const int32* Existing = CellLookup.Find(Coord))
+	{
+		return *Existing;
+	}
+
+	const int32 Index = Cells.AddDefaulted();
+	Cells[Index].Coord = Coord;
+	Cells[Index].Location = Location;
+	CellLookup.Add(Coord, Index);
+	return Index;
+}
+
+void UFireSpreadSubsystem::AddEntry(const FVector& Location, const FFuelEntry& Entry)
+{
+	FFireCell& Cell = Cells[FindOrAddCell(Location)];
+	Cell.Fuel.Add(Entry);
+	Cell.FuelSeconds += FuelPerPiece;
+}
+
+void UFireSpreadSubsystem::AddFuel(ADestructibleTarget* Target)
+{
+	if (!Target) return;
+
+	FFuelEntry Entry;
+	Entry.Actor = Target;
+	AddEntry(Target->GetActorLocation(), Entry);
+}
+
+void UFireSpreadSubsystem::RemoveFuel(ADestructibleTarget* Target)
+{
+	if (!Target) return;
+
+	const int32* Index = CellLookup.Find(ToCoord(Target->GetActorLocation()));
+	if (!Index) return;
+
+	FFireCell& Cell = Cells[*Index];
+	const int32 NumRemoved = Cell.Fuel.RemoveAllSwap([Target](const FFuelEntry& Entry)
+	{
+		return !Entry.bFieldInstance && Entry.Actor.Get() == Target;
+	});
+	Cell.FuelSeconds = FMath::Max(0.f, Cell.FuelSeconds - NumRemoved * FuelPerPiece);
+}
+
+bool UFireSpreadSubsystem::IsBurning(const FVector& Location) const
+{
+	const int32* Index = CellLookup.Find(ToCoord(Location));
+	return Index && Cells[*Index].bBurning;
+}
+
+void UFireSpreadSubsystem::AddFieldFuel(ADestructibleField* Field, uint32 InstanceId, const FVector& Location)
+{
+	if (!Field) return;
+
+	FFuelEntry Entry;
+	Entry.Actor = Field;
+	Entry.InstanceId = InstanceId;
+	Entry.bFieldInstance = true;
+	AddEntry(Location, Entry);
+}
+
+void UFireSpreadSubsystem::IgniteExplosion(const FVector& Location, float ExplosionRadius)
+{
+	const float Radius = ExplosionRadius * IgnitionRadiusScale;
+	const FIntPoint Min = ToCoord(Location - FVector(Radius));
+	const FIntPoint Max = ToCoord(Location + FVector(Radius));
+	const float RadiusSq = FMath::Square(Radius + CellSize * 0.5f);
+
+	for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+	{
+		for (int32 X = Min.X; X <= Max.X; X++)
+		{
+			const int32* Index = CellLookup.Find(FIntPoint(X, Y));
+			if (!Index) continue;
+
+			const FFireCell& Cell = Cells[*Index];
+			const FVector2D Center((X + 0.5f) * CellSize, (Y + 0.5f) * CellSize);
+			if (Cell.CanIgnite() && FVector2D::DistSquared(Center, FVector2D(Location)) <= RadiusSq)
+			{
+				IgniteCell(*Index);
+			}
+		}
+	}
+}
+
+void UFireSpreadSubsystem::IgniteCell(int32 CellIndex)
+{
+	FFireCell& Cell = Cells[CellIndex];
+	Cell.bBurning = true;
+	Cell.Heat = IgnitionHeat;
+	Burning.Add(CellIndex);
+	Warm.Remove(CellIndex);
+
+	if (Sandbox::IsCosmeticDisabled() || Effects.Num() >= MaxFireEffects) return;
+
+	if (!FireSystem && FireEffect.IsValid())
+	{
+		FireSystem = Cast<UNiagaraSystem>(FireEffect.TryLoad());
+	}
+	if (FireSystem)
+	{
+		UNiagaraComponent* Effect = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+			GetWorld(), FireSystem, Cell.Location, FRotator::ZeroRotator, FVector(1.f), true, true, ENCPoolMethod::None);
+		if (Effect)
+		{
+			Effects.Add(CellIndex, Effect);
+		}
+	}
+}
+
+void UFireSpreadSubsystem::ExtinguishCell(int32 CellIndex)
+{
+	FFireCell& Cell = Cells[CellIndex];
+	Cell.bBurning = false;
+	Cell.Heat = 0.f;
+	Cell.FuelSeconds = 0.f;  // Burnt out; new fuel landing here can burn again
+
+	UNiagaraComponent* Effect = nullptr;
+	if (Effects.RemoveAndCopyValue(CellIndex, Effect) && IsValid(Effect))
+	{
+		Effect->Deactivate();
+	}
+}
+
+void UFireSpreadSubsystem::Tick(float DeltaTime)
+{
+	if (Burning.Num() == 0 && Warm.Num() == 0)
+	{
+		StepAccumulator = 0.f;
+		return;
+	}
+
+	// Fixed rate, at most two catch-up steps per frame
+	StepAccumulator = FMath::Min(StepAccumulator + DeltaTime, StepInterval * 2.f);
+	while (StepAccumulator >= StepInterval)
+	{
+		StepAccumulator -= StepInterval;
+		Step(StepInterval);
+	}
+}
+
+void UFireSpreadSubsystem::Step(float StepTime)
+{
+	// === SPREAD (parallel over burning cells) ===
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FireSpread);
+
+		const int32 Chunk = FMath::Max(1, ChunkSize);
+		const int32 NumChunks = FMath::DivideAndRoundUp(Burning.Num(), Chunk);
+		ChunkTransfers.SetNum(NumChunks, EAllowShrinking::No);
+
+		// Each task writes only its own burning cells' fuel and its own transfer list;
+		// neighbours are only read, and nothing changes bBurning until the merge below
+		const float Heat = SpreadHeatPerSecond * StepTime;
+		ParallelFor(NumChunks, [this, Chunk, Heat, StepTime](int32 ChunkIndex)
+		{
+			TArray<FHeatTransfer>& Out = ChunkTransfers[ChunkIndex];
+			Out.Reset();
+
+			const int32 End = FMath::Min(Burning.Num(), (ChunkIndex + 1) * Chunk);
+			for (int32 i = ChunkIndex * Chunk; i < End; i++)
+			{
+				FFireCell& Cell = Cells[Burning[i]];
+				Cell.FuelSeconds -= StepTime;
+
+				for (int32 n = 0; n < 8; n++)
+				{
+					const int32* Neighbour = CellLookup.Find(Cell.Coord + NeighbourOffsets[n]);
+					if (!Neighbour) continue;
+
+					const FFireCell& Other = Cells[*Neighbour];
+					if (!Other.CanIgnite()) continue;
+
+					Out.Add({ *Neighbour, n < 4 ? Heat : Heat * DiagonalHeatScale });
+				}
+			}
+		}, NumChunks < 2 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+
+	// === DAMAGE (game thread - may destroy actors and spawn debris fuel) ===
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FireDamage);
+		ApplyBurnDamage(StepTime);
+	}
+
+	// === MERGE ===
+	for (const TArray<FHeatTransfer>& Transfers : ChunkTransfers)
+	{
+		for (const FHeatTransfer& Transfer : Transfers)
+		{
+			FFireCell& Cell = Cells[Transfer.Cell];
+			if (!Cell.CanIgnite()) continue;
+
+			Cell.Heat += Transfer.Heat;
+			if (Cell.Heat >= IgnitionHeat)
+			{
+				IgniteCell(Transfer.Cell);
+			}
+			else
+			{
+				Warm.Add(Transfer.Cell);
+			}
+		}
+	}
+
+	// Heated cells that didn't catch cool back down
+	const float Cooling = CoolingPerSecond * StepTime;
+	for (auto It = Warm.CreateIterator(); It; ++It)
+	{
+		FFireCell& Cell = Cells[*It];
+		Cell.Heat -= Cooling;
+		if (Cell.bBurning || Cell.Heat <= 0.f)
+		{
+			if (!Cell.bBurning) Cell.Heat = 0.f;
+			It.RemoveCurrent();
+		}
+	}
+
+	// Out of fuel or nothing left to burn
+	for (int32 i = Burning.Num() - 1; i >= 0; i--)
+	{
+		const FFireCell& Cell = Cells[Burning[i]];
+		if (Cell.FuelSeconds <= 0.f || Cell.Fuel.Num() == 0)
+		{
+			ExtinguishCell(Burning[i]);
+			Burning.RemoveAtSwap(i);
+		}
+	}
+}
+
+void UFireSpreadSubsystem::ApplyBurnDamage(float StepTime)
+{
+	const float Damage = BurnDamagePerSecond * StepTime;
+
+	// Collect first - damage destroys actors whose debris registers new fuel (and may add cells)
+	TArray<TWeakObjectPtr<ADestructibleTarget>> Targets;
+	TMap<ADestructibleField*, TArray<uint32>> FieldIds;
+
+	for (int32 CellIndex : Burning)
+	{
+		FFireCell& Cell = Cells[CellIndex];
+		Cell.Fuel.RemoveAllSwap([](const FFuelEntry& Entry) { return !Entry.Actor.IsValid(); });
+
+		for (const FFuelEntry& Entry : Cell.Fuel)
+		{
+			if (Entry.bFieldInstance)
+			{
+				FieldIds.FindOrAdd(CastChecked<ADestructibleField>(Entry.Actor.Get())).Add(Entry.InstanceId);
+			}
+			else
+			{
+				Targets.Add(CastChecked<ADestructibleTarget>(Entry.Actor.Get()));
+			}
+		}
+	}
+
+	// Fields damage instances in place; instances that break or vanished are dropped from their cells
+	TSet<TPair<const AActor*, uint32>> Gone;
+	TArray<uint32> FieldGone;
+	for (TPair<ADestructibleField*, TArray<uint32>>& Pair : FieldIds)
+	{
+		FieldGone.Reset();
+		Pair.Key->ApplyFireDamage(Pair.Value, Damage, FieldGone);
+		for (uint32 Id : FieldGone)
+		{
+			Gone.Add(TPair<const AActor*, uint32>(Pair.Key, Id));
+		}
+	}
+	if (Gone.Num() > 0)
+	{
+		for (int32 CellIndex : Burning)
+		{
+			Cells[CellIndex].Fuel.RemoveAllSwap([&Gone](const FFuelEntry& Entry)
+			{
+				return Entry.bFieldInstance && Gone.Contains(TPair<const AActor*, uint32>(Entry.Actor.Get(), Entry.InstanceId));
+			});
+		}
+	}
+
+	FDamageEvent FireDamage;
+	for (const TWeakObjectPtr<ADestructibleTarget>& Target : Targets)
+	{
+		if (ADestructibleTarget* Actor = Target.Get())
+		{
+			Actor->TakeDamage(Damage, FireDamage, nullptr, nullptr);
+		}
+	}
+}
+
+void UFireSpreadSubsystem::DumpToLog() const
+{
+	int32 NumFuel = 0;
+	for (const FFireCell& Cell : Cells)
+	{
+		NumFuel += Cell.Fuel.Num();
+	}
+	UE_LOG(LogTemp, Display, TEXT("Fire: %d cells, %d fuel pieces, %d burning, %d warm, %d effects"),
+		Cells.Num(), NumFuel, Burning.Num(), Warm.Num(), Effects.Num());
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FireSpreadSubsystem.generated.h"
+
+class ADestructibleTarget;
+class ADestructibleField;
+class UNiagaraComponent;
+class UNiagaraSystem;
+
+/**
+ * Burning as a cellular automaton over a sparse grid.
+ * Flammable destructibles (actors and field instances) register as fuel in the cell they
+ * sit in. Explosions ignite fuelled cells in range; each fixed step, burning cells consume
+ * fuel, damage their contents and heat their 8 neighbours, which ignite once hot enough.
+ * Only burning cells are processed, in parallel chunks; damage is applied on the game
+ * thread afterwards. Nothing ticks per actor and no timers are used.
+ *
+ * Console: Sandbox.Fire
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UFireSpreadSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	void AddFuel(ADestructibleTarget* Target);
+	void AddFieldFuel(ADestructibleField* Field, uint32 InstanceId, const FVector& Location);
+
+	// Take an unburnt actor's fuel back out (it is leaving the world without breaking)
+	void RemoveFuel(ADestructibleTarget* Target);
+	bool IsBurning(const FVector& Location) const;
+
+	// Set every fuelled cell within the blast burning
+	void IgniteExplosion(const FVector& Location, float ExplosionRadius);
+
+	int32 GetNumCells() const { return Cells.Num(); }
+	int32 GetNumBurning() const { return Burning.Num(); }
+
+	void DumpToLog() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FFuelEntry
+	{
+		TWeakObjectPtr<AActor> Actor;   // Flammable ADestructibleTarget, or the owning field
+		uint32 InstanceId = 0;          // Field instance (only when Actor is a field)
+		bool bFieldInstance = false;
+	};
+
+	struct FFireCell
+	{
+		FIntPoint Coord = FIntPoint::ZeroValue;
+		FVector Location = FVector::ZeroVector;  // Where the first fuel was (effect placement)
+		TArray<FFuelEntry> Fuel;
+		float FuelSeconds = 0.f;   // Burn time left, only refilled by new fuel
+		float Heat = 0.f;
+		bool bBurning = false;
+
+		// A burnt-out cell keeps its surviving fuel entries but has no burn time left
+		bool CanIgnite() const { return !bBurning && FuelSeconds > 0.f && Fuel.Num() > 0; }
+	};
+
+	struct FHeatTransfer
+	{
+		int32 Cell = INDEX_NONE;
+		float Heat = 0.f;
+	};
+
+	FIntPoint ToCoord(const FVector& Location) const;
+	int32 FindOrAddCell(const FVector& Location);
+	void AddEntry(const FVector& Location, const FFuelEntry& Entry);
+	void IgniteCell(int32 CellIndex);
+	void ExtinguishCell(int32 CellIndex);
+	void Step(float StepTime);
+	void ApplyBurnDamage(float StepTime);
+
+	// === CONFIG (DefaultGame.ini) ===
+	UPROPERTY(Config)
+	float CellSize = 300.f;
+
+	// Fixed automaton step (seconds)
+	UPROPERTY(Config)
+	float StepInterval = 0.25f;
+
+	// Burn time each piece of fuel adds to its cell
+	UPROPERTY(Config)
+	float FuelPerPiece = 4.f;
+
+	UPROPERTY(Config)
+	float BurnDamagePerSecond = 8.f;
+
+	// Heat per second a burning cell gives each neighbour (diagonals get 70%)
+	UPROPERTY(Config)
+	float SpreadHeatPerSecond = 0.35f;
+
+	UPROPERTY(Config)
+	float IgnitionHeat = 1.f;
+
+	// Blast radius fraction that sets fuel alight
+	UPROPERTY(Config)
+	float IgnitionRadiusScale = 0.6f;
+
+	UPROPERTY(Config)
+	float CoolingPerSecond = 0.1f;
+
+	// Burning cells processed per parallel task
+	UPROPERTY(Config)
+	int32 ChunkSize = 64;
+
+	UPROPERTY(Config)
+	int32 MaxFireEffects = 32;
+
+	UPROPERTY(Config)
+	FSoftObjectPath FireEffect;
+
+	TArray<FFireCell> Cells;
+	TMap<FIntPoint, int32> CellLookup;
+
+	// Active set - only these are stepped
+	TArray<int32> Burning;
+
+	// Heated but not burning, cooled each step
+	TSet<int32> Warm;
+
+	// Per-chunk outputs, reused
+	TArray<TArray<FHeatTransfer>> ChunkTransfers;
+
+	UPROPERTY()
+	TMap<int32, UNiagaraComponent*> Effects;
+
+	UPROPERTY()
+	UNiagaraSystem* FireSystem = nullptr;
+
+	float StepAccumulator = 0.f;
+};
@@ -0,0 +1,315 @@
+#include "HibernationSubsystem.h"
+#include "Destructibles/DestructibleTarget.h"
+#include "Systems/DestructionStateSubsystem.h"
+#include "Systems/FireSpreadSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hibernation Scan"), STAT_HibernationScan, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Hibernation Restore"), STAT_HibernationRestore, STATGROUP_Game);
+
+static FAutoConsoleCommandWithWorld CmdHibernation(
+	TEXT("Sandbox.Hibernation"),
+	TEXT("Print live vs hibernated destructible counts"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (UHibernationSubsystem* Hibernation = World ? World->GetSubsystem<UHibernationSubsystem>() : nullptr)
+		{
+			Hibernation->DumpToLog();
+		}
+	}));
+
+bool UHibernationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UHibernationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHibernationSubsystem, STATGROUP_Tickables);
+}
+
+void UHibernationSubsystem::Deinitialize()
+{
+	Cells.Reset();
+	Classes.Reset();
+	ClassIndices.Reset();
+	HibernateQueue.Reset();
+	WakeQueue.Reset();
+	NumRecords = 0;
+	Super::Deinitialize();
+}
+
+FIntPoint UHibernationSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+float UHibernationSubsystem::GetDistanceToCell(const FIntPoint& Cell) const
+{
+	// 2D distance from the nearest player to the nearest point of the cell
+	const FBox2D CellBox(FVector2D(Cell) * CellSize, FVector2D(Cell + FIntPoint(1, 1)) * CellSize);
+	float NearestSq = MAX_flt;
+	for (const FVector& Player : PlayerLocations)
+	{
+		NearestSq = FMath::Min(NearestSq, (float)CellBox.ComputeSquaredDistanceToPoint(FVector2D(Player)));
+	}
+	return NearestSq < MAX_flt ? FMath::Sqrt(NearestSq) : MAX_flt;
+}
+
+bool UHibernationSubsystem::IsSettled(const ADestructibleTarget* Target) const
+{
+	if (!IsValid(Target) || Target->IsActorBeingDestroyed() || !Target->HasAuthority()) return false;
+
+	// Records only carry a uniform scale
+	if (!Target->GetActorScale3D().IsUniform()) return false;
+
+	// Debris must be at rest; intact objects never simulate
+	UStaticMeshComponent* Mesh = Target->GetMesh();
+	if (!Mesh || (Target->GetBreakDepth() > 0 && Mesh->IsAnyRigidBodyAwake())) return false;
+
+	// Burning fuel stays live until the fire is out
+	const UFireSpreadSubsystem* Fire = GetWorld()->GetSubsystem<UFireSpreadSubsystem>();
+	return !(Target->IsFlammable() && Fire && Fire->IsBurning(Target->GetActorLocation()));
+}
+
+void UHibernationSubsystem::Tick(float DeltaTime)
+{
+	// Destructibles are replicated from the server - a client destroying its copies would only desync
+	if (GetWorld()->GetNetMode() == NM_Client) return;
+
+	ScanTimer -= DeltaTime;
+	if (ScanTimer <= 0.f)
+	{
+		ScanTimer = ScanInterval;
+		GatherPlayerLocations();
+
+		// Without anyone to measure from (dedicated server before login) leave the world as it is
+		if (PlayerLocations.Num() > 0)
+		{
+			SCOPE_CYCLE_COUNTER(STAT_HibernationScan);
+			ScanForHibernation();
+			ScanForWake();
+		}
+	}
+
+	// === HIBERNATE ===
+	int32 Budget = MaxHibernatesPerFrame;
+	while (Budget > 0 && HibernateQueue.Num() > 0)
+	{
+		ADestructibleTarget* Target = HibernateQueue.Pop(EAllowShrinking::No).Get();
+
+		// Re-check, it may have been hit or a player may have come closer since the scan
+		if (IsSettled(Target) && GetDistanceToCell(GetCell(Target->GetActorLocation())) > FMath::Max(HibernateDistance, WakeDistance))
+		{
+			Hibernate(Target);
+			Budget--;
+		}
+	}
+
+	// === RESTORE ===
+	SCOPE_CYCLE_COUNTER(STAT_HibernationRestore);
+	Budget = MaxRestoresPerFrame;
+	while (Budget > 0 && WakeQueue.Num() > 0)
+	{
+		const FIntPoint Cell = WakeQueue.Last();
+		TArray<FHibernatedRecord>* Records = Cells.Find(Cell);
+		while (Records && Budget > 0 && Records->Num() > 0)
+		{
+			RestoreRecord(Records->Pop(EAllowShrinking::No));
+			NumRecords--;
+			Budget--;
+		}
+
+		if (!Records || Records->Num() == 0)
+		{
+			Cells.Remove(Cell);
+			WakeQueue.Pop(EAllowShrinking::No);
+		}
+	}
+}
+
+void UHibernationSubsystem::GatherPlayerLocations()
+{
+	// Every player counts, not just local views - a remote client's surroundings must stay live on the server
+	PlayerLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (const APawn* Pawn = PC ? PC->GetPawnOrSpectator() : nullptr)
+		{
+			PlayerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+}
+
+void UHibernationSubsystem::ScanForHibernation()
+{
+	const float Distance = FMath::Max(HibernateDistance, WakeDistance);
+
+	// Many actors share a cell, decide each cell once
+	TMap<FIntPoint, bool> FarCells;
+	HibernateQueue.Reset();
+
+	for (TActorIterator<ADestructibleTarget> It(GetWorld()); It; ++It)
+	{
+		const FIntPoint Cell = GetCell(It->GetActorLocation());
+		bool* bFar = FarCells.Find(Cell);
+		if (!bFar)
+		{
+			bFar = &FarCells.Add(Cell, GetDistanceToCell(Cell) > Distance);
+		}
+
+		if (*bFar && IsSettled(*It))
+		{
+			HibernateQueue.Add(*It);
+		}
+	}
+}
+
+void UHibernationSubsystem::ScanForWake()
+{
+	for (const TPair<FIntPoint, TArray<FHibernatedRecord>>& Pair : Cells)
+	{
+		if (GetDistanceToCell(Pair.Key) <= WakeDistance)
+		{
+			WakeQueue.AddUnique(Pair.Key);
+		}
+	}
+}
+
+void UHibernationSubsystem::Hibernate(ADestructibleTarget* Target)
+{
+	UClass* Class = Target->GetClass();
+	uint16* ClassIndex = ClassIndices.Find(Class);
+	if (!ClassIndex)
+	{
+		ClassIndex = &ClassIndices.Add(Class, (uint16)Classes.Add(Class));
+	}
+
+	const FTransform Transform = Target->GetActorTransform();
+	const FVector Pos = Transform.GetLocation() * DestructionFormat::PositionScale;
+
+	FHibernatedRecord Record;
+	FMemory::Memzero(Record);
+	Record.ClassIndex = *ClassIndex;
+	Record.Depth = (uint8)FMath::Clamp(Target->GetBreakDepth(), 0, 255);
+	Record.Position[0] = FMath::RoundToInt32(Pos.X);
+	Record.Position[1] = FMath::RoundToInt32(Pos.Y);
+	Record.Position[2] = FMath::RoundToInt32(Pos.Z);
+	Record.Rotation = UDestructionStateSubsystem::PackRotation(Transform.GetRotation());
+	Record.Color = Target->GetDebrisColor().ToFColor(true);
+	Record.Scale = (uint16)FMath::Clamp(FMath::RoundToInt(Transform.GetScale3D().X * DestructionFormat::ScaleScale), 1, MAX_uint16);
+	Record.Health = Target->GetCurrentHealth();
+	Record.PersistentId = Target->GetPersistentId();
+
+	// Leaving without breaking - give the fuel back so a restore doesn't add it twice.
+	// Fuel is found through the live actor, so this has to happen before Destroy.
+	UFireSpreadSubsystem* Fire = Target->IsFlammable() ? GetWorld()->GetSubsystem<UFireSpreadSubsystem>() : nullptr;
+	if (Fire)
+	{
+		Fire->RemoveFuel(Target);
+	}
+
+	// EndPlay takes it out of the occlusion grid, the physics scene goes with the component
+	if (!Target->Destroy())
+	{
+		// Still in the world - keep its fuel and don't record a copy that would spawn a twin
+		if (Fire)
+		{
+			Fire->AddFuel(Target);
+		}
+		return;
+	}
+
+	Cells.FindOrAdd(GetCell(Transform.GetLocation())).Add(Record);
+	NumRecords++;
+	NumHibernatedTotal++;
+}
+
+FTransform UHibernationSubsystem::GetRecordTransform(const FHibernatedRecord& Record) const
+{
+	return FTransform(
+		UDestructionStateSubsystem::UnpackRotation(Record.Rotation),
+		FVector(Record.Position[0], Record.Position[1], Record.Position[2]) / DestructionFormat::PositionScale,
+		FVector(Record.Scale / DestructionFormat::ScaleScale));
+}
+
+void UHibernationSubsystem::RestoreRecord(const FHibernatedRecord& Record)
+{
+	UClass* Class = Classes.IsValidIndex(Record.ClassIndex) ? Classes[Record.ClassIndex].Get() : nullptr;
+	if (!Class) return;
+
+	const FTransform Transform = GetRecordTransform(Record);
+	ADestructibleTarget* Target = GetWorld()->SpawnActorDeferred<ADestructibleTarget>(
+		Class, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Target) return;
+
+	// Depth, scale and health through the same path as a loaded snapshot.
+	// ID before BeginPlay so level objects keep theirs instead of hashing the new name.
+	Target->RestoreDebrisState(Record.Depth, FLinearColor(Record.Color));
+	Target->SetPersistentId(Record.PersistentId);
+	Target->FinishSpawning(Transform);
+	Target->SetCurrentHealth(Record.Health);
+	NumRestoredTotal++;
+}
+
+void UHibernationSubsystem::RestoreAll()
+{
+	const int32 NumRestored = NumRecords;
+	for (const TPair<FIntPoint, TArray<FHibernatedRecord>>& Pair : Cells)
+	{
+		for (const FHibernatedRecord& Record : Pair.Value)
+		{
+			RestoreRecord(Record);
+		}
+	}
+	Cells.Reset();
+	WakeQueue.Reset();
+	HibernateQueue.Reset();
+	NumRecords = 0;
+
+	// Keep everything live until the next scan
+	ScanTimer = ScanInterval;
+
+	if (NumRestored > 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("Hibernation: restored all %d records"), NumRestored);
+	}
+}
+
+void UHibernationSubsystem::GetObstacleBounds(TArray<FBox>& OutBoxes) const
+{
+	for (const TPair<FIntPoint, TArray<FHibernatedRecord>>& Pair : Cells)
+	{
+		for (const FHibernatedRecord& Record : Pair.Value)
+		{
+			if (Record.Depth != 0 || !Classes.IsValidIndex(Record.ClassIndex) || !Classes[Record.ClassIndex]) continue;
+
+			const UStaticMeshComponent* Mesh = Classes[Record.ClassIndex]->GetDefaultObject<ADestructibleTarget>()->GetMesh();
+			if (const UStaticMesh* StaticMesh = Mesh ? Mesh->GetStaticMesh() : nullptr)
+			{
+				OutBoxes.Add(StaticMesh->GetBoundingBox().TransformBy(GetRecordTransform(Record)));
+			}
+		}
+	}
+}
+
+void UHibernationSubsystem::DumpToLog() const
+{
+	int32 NumLive = 0;
+	for (TActorIterator<ADestructibleTarget> It(GetWorld()); It; ++It)
+	{
+		NumLive++;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Hibernation: %d live destructibles, %d hibernated in %d cells (%d KB), %d players"),
+		NumLive, NumRecords, Cells.Num(), (int32)(NumRecords * sizeof(FHibernatedRecord) / 1024), PlayerLocations.Num());
+	UE_LOG(LogTemp, Display, TEXT("  queued: %d to hibernate, %d cells to wake; totals: %d hibernated, %d restored"),
+		HibernateQueue.Num(), WakeQueue.Num(), NumHibernatedTotal, NumRestoredTotal);
+}
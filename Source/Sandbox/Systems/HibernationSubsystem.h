@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HibernationSubsystem.generated.h"
+
+class ADestructibleTarget;
+
+// One hibernated destructible - the snapshot's debris quantization plus what an intact object needs
+struct FHibernatedRecord
+{
+	uint16 ClassIndex;
+	uint8 Depth;
+	uint8 Padding;
+	int32 Position[3];     // Quantized by DestructionFormat::PositionScale
+	uint32 Rotation;       // UDestructionStateSubsystem::PackRotation
+	FColor Color;          // sRGB
+	uint16 Scale;          // Quantized by DestructionFormat::ScaleScale
+	uint16 Padding2;
+	float Health;
+	uint32 PersistentId;
+};
+static_assert(sizeof(FHibernatedRecord) == 36, "Hibernated record layout changed");
+
+/**
+ * Keeps registered destructible actors proportional to the area around players.
+ * The level is split into square cells; settled destructibles in cells far from every
+ * player are packed into compact records and their actors (and physics state) released.
+ * When a player comes back within WakeDistance the cell is respawned in bulk, a budget
+ * of actors per frame.
+ *
+ * Console: Sandbox.Hibernation
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UHibernationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Respawn everything now (before saving or loading a destruction snapshot)
+	void RestoreAll();
+
+	// World bounds of hibernated intact objects - they still block navigation
+	void GetObstacleBounds(TArray<FBox>& OutBoxes) const;
+
+	int32 GetNumHibernated() const { return NumRecords; }
+	void DumpToLog() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+	float GetDistanceToCell(const FIntPoint& Cell) const;
+	bool IsSettled(const ADestructibleTarget* Target) const;
+
+	void GatherPlayerLocations();
+	void ScanForHibernation();
+	void ScanForWake();
+
+	void Hibernate(ADestructibleTarget* Target);
+	void RestoreRecord(const FHibernatedRecord& Record);
+	FTransform GetRecordTransform(const FHibernatedRecord& Record) const;
+
+	// === CONFIG (DefaultGame.ini) ===
+	UPROPERTY(Config)
+	float CellSize = 4000.f;
+
+	// Cells further than this from every player hibernate...
+	UPROPERTY(Config)
+	float HibernateDistance = 20000.f;
+
+	// ...and wake once a player is within this (less, so cells on the edge don't flap)
+	UPROPERTY(Config)
+	float WakeDistance = 15000.f;
+
+	UPROPERTY(Config)
+	float ScanInterval = 0.5f;
+
+	UPROPERTY(Config)
+	int32 MaxHibernatesPerFrame = 64;
+
+	UPROPERTY(Config)
+	int32 MaxRestoresPerFrame = 32;
+
+	// Class table shared by every record
+	UPROPERTY()
+	TArray<TSubclassOf<ADestructibleTarget>> Classes;
+
+	TMap<UClass*, uint16> ClassIndices;
+	TMap<FIntPoint, TArray<FHibernatedRecord>> Cells;
+	int32 NumRecords = 0;
+
+	TArray<TWeakObjectPtr<ADestructibleTarget>> HibernateQueue;
+	TArray<FIntPoint> WakeQueue;
+
+	TArray<FVector> PlayerLocations;
+	float ScanTimer = 0.f;
+
+	// Totals for Sandbox.Hibernation
+	int32 NumHibernatedTotal = 0;
+	int32 NumRestoredTotal = 0;
+};
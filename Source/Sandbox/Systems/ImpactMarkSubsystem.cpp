@@ -0,0 +1,139 @@
+#include "ImpactMarkSubsystem.h"
+#include "Sandbox.h"
+#include "ViewSignificanceSubsystem.h"
+#include "Components/DecalComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialInterface.h"
+
+void UImpactMarkSubsystem::Deinitialize()
+{
+	if (PoolOwner)
+	{
+		PoolOwner->Destroy();
+		PoolOwner = nullptr;
+	}
+	Decals.Reset();
+	Marks.Reset();
+	ScorchMaterial = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UImpactMarkSubsystem::AddExplosionMark(const FVector& Location, float ExplosionRadius)
+{
+	// Nobody to see them
+	if (Sandbox::IsCosmeticDisabled()) return;
+
+	// Too far from every view to make out - don't spend a pooled decal on it
+	UViewSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UViewSignificanceSubsystem>();
+	if (Significance && Significance->GetSignificance(Location) == EViewSignificance::Far) return;
+
+	AddMark(Location, ExplosionRadius * MarkRadiusScale);
+}
+
+bool UImpactMarkSubsystem::EnsurePool()
+{
+	if (PoolOwner) return true;
+
+	UWorld* World = GetWorld();
+	if (!World || Capacity <= 0) return false;
+
+	FActorSpawnParameters Params;
+	Params.ObjectFlags |= RF_Transient;
+	PoolOwner = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+	if (!PoolOwner) return false;
+
+	USceneComponent* Root = NewObject<USceneComponent>(PoolOwner, TEXT("Root"));
+	PoolOwner->SetRootComponent(Root);
+	Root->RegisterComponent();
+
+	Decals.Reserve(Capacity);
+	Marks.Reserve(Capacity);
+	return true;
+}
+
+UMaterialInterface* UImpactMarkSubsystem::GetScorchMaterial()
+{
+	if (ScorchMaterial) return ScorchMaterial;
+
+	UMaterialInterface* Base = DecalMaterial.IsValid() ? Cast<UMaterialInterface>(DecalMaterial.TryLoad()) : nullptr;
+	if (!Base)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ImpactMarks: %s not found, tinting the engine decal material"), *DecalMaterial.ToString());
+		Base = LoadObject<UMaterialInterface>(nullptr, TEXT("/Engine/EngineMaterials/DefaultDeferredDecalMaterial.DefaultDeferredDecalMaterial"));
+	}
+	if (!Base) return nullptr;
+
+	ScorchMaterial = UMaterialInstanceDynamic::Create(Base, this);
+	ScorchMaterial->SetVectorParameterValue(TEXT("Color"), ScorchColor);
+	return ScorchMaterial;
+}
+
+void UImpactMarkSubsystem::AddMark(const FVector& Location, float Radius)
+{
+	if (Radius <= 0.f || !EnsurePool()) return;
+
+	// Overlapping an existing mark - grow it rather than stacking another decal
+	for (int32 i = 0; i < Marks.Num(); i++)
+	{
+		FImpactMark& Mark = Marks[i];
+		const float Dist = FVector::Dist(Mark.Center, Location);
+		if (Dist < (Mark.Radius + Radius) * MergeOverlap)
+		{
+			Mark.Center = FMath::Lerp(Mark.Center, Location, Radius / (Mark.Radius + Radius));
+			Mark.Radius = FMath::Min(MaxMarkRadius, FMath::Max(Mark.Radius, Radius) + Dist * 0.5f);
+			Mark.LastHit = ++HitCounter;
+			PlaceDecal(i);
+			return;
+		}
+	}
+
+	int32 Slot;
+	if (Marks.Num() < Capacity)
+	{
+		Slot = Marks.AddDefaulted();
+
+		UDecalComponent* Decal = NewObject<UDecalComponent>(PoolOwner);
+		Decal->SetDecalMaterial(GetScorchMaterial());
+		Decal->SetupAttachment(PoolOwner->GetRootComponent());
+		Decal->RegisterComponent();
+		Decals.Add(Decal);
+	}
+	else
+	{
+		// Full - recycle the one hit longest ago
+		Slot = 0;
+		for (int32 i = 1; i < Marks.Num(); i++)
+		{
+			if (Marks[i].LastHit < Marks[Slot].LastHit)
+			{
+				Slot = i;
+			}
+		}
+	}
+
+	FImpactMark& Mark = Marks[Slot];
+	Mark.Center = Location;
+	Mark.Radius = FMath::Min(Radius, MaxMarkRadius);
+	Mark.Yaw = FMath::FRandRange(0.f, 360.f);
+	Mark.LastHit = ++HitCounter;
+	PlaceDecal(Slot);
+}
+
+void UImpactMarkSubsystem::PlaceDecal(int32 Slot)
+{
+	UDecalComponent* Decal = Decals[Slot];
+	if (!Decal) return;
+
+	const FImpactMark& Mark = Marks[Slot];
+
+	// Decals project along +X - point it down onto the ground
+	Decal->SetWorldLocationAndRotation(Mark.Center, FRotator(-90.f, Mark.Yaw, 0.f));
+	Decal->DecalSize = FVector(Mark.Radius * 0.5f, Mark.Radius, Mark.Radius);
+
+	// Newest mark draws on top
+	Decal->SetSortOrder(NextSortOrder++);
+	Decal->MarkRenderStateDirty();
+}
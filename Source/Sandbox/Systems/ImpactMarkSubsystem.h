@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ImpactMarkSubsystem.generated.h"
+
+class UDecalComponent;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+
+/**
+ * Scorch marks for shell impacts and barrel explosions.
+ * A fixed pool of decal components is recycled least-recently-hit first, and a mark landing
+ * on top of an existing one grows that one instead of stacking a new decal, so mark
+ * memory and draw cost are bounded no matter how long the session runs.
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UImpactMarkSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Mark size is derived from the explosion radius
+	void AddExplosionMark(const FVector& Location, float ExplosionRadius);
+
+	int32 GetNumMarks() const { return Marks.Num(); }
+
+private:
+	struct FImpactMark
+	{
+		FVector Center = FVector::ZeroVector;
+		float Radius = 0.f;
+		float Yaw = 0.f;        // Picked once so a merged mark doesn't spin
+		uint64 LastHit = 0;     // Recycling picks the smallest
+	};
+
+	void AddMark(const FVector& Location, float Radius);
+	bool EnsurePool();
+	UMaterialInterface* GetScorchMaterial();
+	void PlaceDecal(int32 Slot);
+
+	// === CONFIG (DefaultGame.ini) ===
+	UPROPERTY(Config)
+	int32 Capacity = 96;
+
+	UPROPERTY(Config)
+	float MarkRadiusScale = 0.5f;
+
+	// Merged marks never grow past this
+	UPROPERTY(Config)
+	float MaxMarkRadius = 600.f;
+
+	// Marks merge when centers are closer than this fraction of their combined radii
+	UPROPERTY(Config)
+	float MergeOverlap = 0.5f;
+
+	// Scorch decal; if it's missing the engine decal material is tinted instead
+	UPROPERTY(Config)
+	FSoftObjectPath DecalMaterial;
+
+	UPROPERTY(Config)
+	FLinearColor ScorchColor = FLinearColor(0.02f, 0.015f, 0.01f, 1.f);
+
+	// Owns the pooled decals
+	UPROPERTY()
+	AActor* PoolOwner = nullptr;
+
+	UPROPERTY()
+	TArray<UDecalComponent*> Decals;
+
+	// Shared by every decal so they batch
+	UPROPERTY()
+	UMaterialInstanceDynamic* ScorchMaterial = nullptr;
+
+	// Parallel to Decals; grows to Capacity then recycles the least recently hit slot
+	TArray<FImpactMark> Marks;
+	uint64 HitCounter = 0;
+	int32 NextSortOrder = 0;
+};
@@ -0,0 +1,190 @@
+#include "MachineGunSubsystem.h"
+#include "Sandbox.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/DamageEvents.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+DECLARE_CYCLE_STAT(TEXT("MachineGun Resolve"), STAT_MachineGunResolve, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("MachineGun Issue"), STAT_MachineGunIssue, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("MachineGun Tracers"), STAT_MachineGunTracers, STATGROUP_Game);
+
+bool UMachineGunSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UMachineGunSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMachineGunSubsystem, STATGROUP_Tickables);
+}
+
+void UMachineGunSubsystem::Deinitialize()
+{
+	if (TracerOwner)
+	{
+		TracerOwner->Destroy();
+		TracerOwner = nullptr;
+	}
+	TracerMesh = nullptr;
+	Pending.Reset();
+	InFlight.Reset();
+
+	Super::Deinitialize();
+}
+
+void UMachineGunSubsystem::QueueShot(AActor* Shooter, const FVector& Start, const FVector& Direction)
+{
+	FShot& Shot = Pending.AddDefaulted_GetRef();
+	Shot.Shooter = Shooter;
+	Shot.Start = Start;
+	Shot.End = Start + Direction.GetSafeNormal() * Range;
+}
+
+void UMachineGunSubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_MachineGunResolve);
+		ResolveShots(World);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_MachineGunIssue);
+		IssueShots(World);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_MachineGunTracers);
+		UpdateTracers(DeltaTime);
+	}
+}
+
+void UMachineGunSubsystem::IssueShots(UWorld* World)
+{
+	for (FShot& Shot : Pending)
+	{
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(MachineGun), false, Shot.Shooter.Get());
+		Shot.Trace = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Shot.Start, Shot.End, ECC_Visibility, Params);
+	}
+
+	// Pending becomes next frame's in-flight batch; both arrays keep their allocations
+	Swap(Pending, InFlight);
+	Pending.Reset();
+}
+
+void UMachineGunSubsystem::ResolveShots(UWorld* World)
+{
+	FTraceDatum Datum;
+	for (const FShot& Shot : InFlight)
+	{
+		FVector End = Shot.End;
+
+		if (Shot.Trace.IsValid() && World->QueryTraceData(Shot.Trace, Datum))
+		{
+			for (const FHitResult& Hit : Datum.OutHits)
+			{
+				if (!Hit.bBlockingHit) continue;
+
+				End = Hit.ImpactPoint;
+
+				// Instanced fields take the instance from HitInfo.Item
+				if (AActor* HitActor = Hit.GetActor())
+				{
+					AActor* Shooter = Shot.Shooter.Get();
+					FPointDamageEvent DamageEvent(Damage, Hit, (End - Shot.Start).GetSafeNormal(), nullptr);
+					HitActor->TakeDamage(Damage, DamageEvent,
+						Shooter ? Shooter->GetInstigatorController() : nullptr, Shooter);
+				}
+				break;
+			}
+		}
+
+		AddTracer(Shot.Start, End);
+	}
+	InFlight.Reset();
+}
+
+bool UMachineGunSubsystem::EnsureTracerMesh()
+{
+	if (TracerMesh) return true;
+	if (Sandbox::IsCosmeticDisabled()) return false;
+
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	UMaterialInterface* BaseMat = LoadObject<UMaterialInterface>(nullptr, TEXT("/Engine/BasicShapes/BasicShapeMaterial.BasicShapeMaterial"));
+	if (!Cube) return false;
+
+	FActorSpawnParameters Params;
+	Params.ObjectFlags |= RF_Transient;
+	TracerOwner = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+	if (!TracerOwner) return false;
+
+	TracerMesh = NewObject<UInstancedStaticMeshComponent>(TracerOwner, TEXT("Tracers"));
+	TracerOwner->SetRootComponent(TracerMesh);
+	TracerMesh->SetStaticMesh(Cube);
+	TracerMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	TracerMesh->SetCastShadow(false);
+	if (BaseMat)
+	{
+		UMaterialInstanceDynamic* Mat = UMaterialInstanceDynamic::Create(BaseMat, TracerOwner);
+		Mat->SetVectorParameterValue(TEXT("Color"), FLinearColor(1.f, 0.7f, 0.2f));
+		TracerMesh->SetMaterial(0, Mat);
+	}
+	TracerMesh->RegisterComponent();
+
+	// Fixed instance count - inactive tracers are zero-scaled, never removed
+	Tracers.SetNum(MaxTracers);
+	TracerTransforms.Init(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), MaxTracers);
+	TracerMesh->AddInstances(TracerTransforms, false, true);
+	return true;
+}
+
+void UMachineGunSubsystem::AddTracer(const FVector& Start, const FVector& End)
+{
+	if (!EnsureTracerMesh()) return;
+
+	FTracer& Tracer = Tracers[NextTracer];
+	NextTracer = (NextTracer + 1) % MaxTracers;
+
+	const FVector Delta = End - Start;
+	Tracer.Start = Start;
+	Tracer.Distance = Delta.Size();
+	Tracer.Direction = Tracer.Distance > KINDA_SMALL_NUMBER ? Delta / Tracer.Distance : FVector::ForwardVector;
+	Tracer.Age = 0.f;
+	Tracer.bActive = true;
+	bTracersDirty = true;
+}
+
+void UMachineGunSubsystem::UpdateTracers(float DeltaTime)
+{
+	if (!TracerMesh || !bTracersDirty) return;
+
+	bTracersDirty = false;
+	for (int32 i = 0; i < Tracers.Num(); i++)
+	{
+		FTracer& Tracer = Tracers[i];
+		if (!Tracer.bActive) continue;
+
+		Tracer.Age += DeltaTime;
+		const float Head = FMath::Min(Tracer.Age * TracerSpeed, Tracer.Distance);
+		const float Tail = FMath::Max(Tracer.Age * TracerSpeed - TracerLength, 0.f);
+
+		if (Tail >= Tracer.Distance)
+		{
+			Tracer.bActive = false;
+			TracerTransforms[i].SetScale3D(FVector::ZeroVector);
+			bTracersDirty = true;  // One more pass to push the hide
+			continue;
+		}
+
+		// Cube is 100 units on a side, centered
+		const FVector Center = Tracer.Start + Tracer.Direction * ((Head + Tail) * 0.5f);
+		TracerTransforms[i] = FTransform(Tracer.Direction.ToOrientationQuat(), Center,
+			FVector(FMath::Max(Head - Tail, 1.f) / 100.f, 0.04f, 0.04f));
+		bTracersDirty = true;
+	}
+
+	TracerMesh->BatchUpdateInstancesTransforms(0, TracerTransforms, true, true, false);
+}
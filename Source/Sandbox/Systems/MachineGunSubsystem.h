@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "MachineGunSubsystem.generated.h"
+
+class UInstancedStaticMeshComponent;
+
+/**
+ * Hitscan rounds for every coaxial machine gun in the world.
+ * Guns queue rounds during their Tick; this subsystem issues them as one batch of async
+ * line traces, resolves last frame's batch (damage via TakeDamage with a point event),
+ * and draws all tracers through a single instanced mesh with a fixed instance count.
+ * No actors are spawned per round.
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UMachineGunSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Queue a round for this frame's trace batch
+	void QueueShot(AActor* Shooter, const FVector& Start, const FVector& Direction);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FShot
+	{
+		TWeakObjectPtr<AActor> Shooter;
+		FVector Start = FVector::ZeroVector;
+		FVector End = FVector::ZeroVector;
+		FTraceHandle Trace;
+	};
+
+	struct FTracer
+	{
+		FVector Start = FVector::ZeroVector;
+		FVector Direction = FVector::ForwardVector;
+		float Distance = 0.f;
+		float Age = 0.f;
+		bool bActive = false;
+	};
+
+	void ResolveShots(UWorld* World);
+	void IssueShots(UWorld* World);
+	void AddTracer(const FVector& Start, const FVector& End);
+	void UpdateTracers(float DeltaTime);
+	bool EnsureTracerMesh();
+
+	// === CONFIG (DefaultGame.ini) ===
+	UPROPERTY(Config)
+	float Range = 15000.f;
+
+	UPROPERTY(Config)
+	float Damage = 6.f;
+
+	UPROPERTY(Config)
+	float TracerSpeed = 40000.f;
+
+	UPROPERTY(Config)
+	float TracerLength = 400.f;
+
+	// Oldest tracer is recycled once all are in use
+	static constexpr int32 MaxTracers = 128;
+
+	// Queued this frame, traced at the end of Tick
+	TArray<FShot> Pending;
+
+	// Traced last frame, resolved at the start of Tick
+	TArray<FShot> InFlight;
+
+	// Owns the tracer mesh
+	UPROPERTY()
+	AActor* TracerOwner = nullptr;
+
+	UPROPERTY()
+	UInstancedStaticMeshComponent* TracerMesh = nullptr;
+
+	TArray<FTracer> Tracers;
+	TArray<FTransform> TracerTransforms;
+	int32 NextTracer = 0;
+	bool bTracersDirty = false;
+};
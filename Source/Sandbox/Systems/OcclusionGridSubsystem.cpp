@@ -0,0 +1,492 @@
+#include "OcclusionGridSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/DamageEvents.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/DamageType.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Occlusion Radial Damage"), STAT_OcclusionRadialDamage, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Occlusion March"), STAT_OcclusionMarch, STATGROUP_Game);
+
+static FAutoConsoleCommandWithWorldAndArgs CmdOcclusion(
+	TEXT("Sandbox.Occlusion"),
+	TEXT("Radial damage line of sight: Grid (voxel march), Trace (physics traces) or Validate (both, count disagreements). No args prints stats."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UOcclusionGridSubsystem* Occlusion = World ? World->GetSubsystem<UOcclusionGridSubsystem>() : nullptr;
+		if (!Occlusion) return;
+
+		if (Args.Num() > 0)
+		{
+			if (Args[0].Equals(TEXT("Grid"), ESearchCase::IgnoreCase)) Occlusion->SetMode(UOcclusionGridSubsystem::EMode::Grid);
+			else if (Args[0].Equals(TEXT("Trace"), ESearchCase::IgnoreCase)) Occlusion->SetMode(UOcclusionGridSubsystem::EMode::Trace);
+			else if (Args[0].Equals(TEXT("Validate"), ESearchCase::IgnoreCase)) Occlusion->SetMode(UOcclusionGridSubsystem::EMode::Validate);
+		}
+		Occlusion->DumpToLog();
+	}));
+
+bool UOcclusionGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UOcclusionGridSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SizeX = SizeY = FMath::Max(1, GridCells);
+	SizeZ = FMath::Max(1, HeightCells);
+	GridOrigin = FVector(-0.5f * SizeX * CellSize, -0.5f * SizeY * CellSize, GridMinZ);
+	Counts.SetNumZeroed(SizeX * SizeY * SizeZ);
+}
+
+void UOcclusionGridSubsystem::Deinitialize()
+{
+	Counts.Empty();
+	Blockers.Empty();
+
+	Super::Deinitialize();
+}
+
+void UOcclusionGridSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Static level geometry never changes - voxelize it once. Destructibles register themselves.
+	for (TActorIterator<AActor> It(&InWorld); It; ++It)
+	{
+		TInlineComponentArray<UPrimitiveComponent*> Primitives(*It);
+		for (UPrimitiveComponent* Primitive : Primitives)
+		{
+			if (Primitive->Mobility == EComponentMobility::Static
+				&& Primitive->IsQueryCollisionEnabled()
+				&& Primitive->GetCollisionResponseToChannel(ECC_Visibility) == ECR_Block
+				&& !Primitive->IsA<UInstancedStaticMeshComponent>())
+			{
+				AddComponent(Primitive);
+			}
+		}
+	}
+}
+
+bool UOcclusionGridSubsystem::RasterizeSolid(const FBox& LocalBounds, const FTransform& Transform, FBlockerCells& OutCells) const
+{
+	const FVector Scale = Transform.GetScale3D().GetAbs();
+	const FVector Center = LocalBounds.GetCenter();
+	FVector Extent = LocalBounds.GetExtent();
+
+	// A wall thinner than a cell would otherwise fall between cell centers. Thicken only that
+	// axis, to one cell measured across the grid, so a ray stepping cell to cell can't slip
+	// between two diagonal cells of a rotated wall. The other axes keep their true extent.
+	for (int32 Axis = 0; Axis < 3; Axis++)
+	{
+		if (Scale[Axis] < UE_KINDA_SMALL_NUMBER) return false;
+
+		const float Thickness = 2.f * Extent[Axis] * Scale[Axis];
+		const FVector Dir = Transform.GetUnitAxis((EAxis::Type)(Axis + 1));
+		const float OneCell = CellSize * (FMath::Abs(Dir.X) + FMath::Abs(Dir.Y) + FMath::Abs(Dir.Z));
+		if (Thickness < OneCell)
+		{
+			if (Thickness < MinBlockerSize) return false;
+			Extent[Axis] = 0.5f * OneCell / Scale[Axis];
+		}
+	}
+
+	const FBox Solid(Center - Extent, Center + Extent);
+	const FBox WorldBounds = Solid.TransformBy(Transform);
+	const FVector Lo = (WorldBounds.Min - GridOrigin) / CellSize - 0.5f;
+	const FVector Hi = (WorldBounds.Max - GridOrigin) / CellSize - 0.5f;
+
+	FCellBox& Box = OutCells.Box;
+	Box.Min = FIntVector(FMath::Max(FMath::CeilToInt(Lo.X), 0), FMath::Max(FMath::CeilToInt(Lo.Y), 0), FMath::Max(FMath::CeilToInt(Lo.Z), 0));
+	Box.Max = FIntVector(FMath::Min(FMath::FloorToInt(Hi.X), SizeX - 1), FMath::Min(FMath::FloorToInt(Hi.Y), SizeY - 1), FMath::Min(FMath::FloorToInt(Hi.Z), SizeZ - 1));
+	OutCells.Cells.Reset();
+	if (Box.IsEmpty()) return false;
+
+	// Axis-aligned - every cell in the range is inside
+	if (Transform.GetRotation().IsIdentity(UE_KINDA_SMALL_NUMBER)) return true;
+
+	// Rotated - keep the cells whose centers fall inside the box in its own space
+	const FBox Inside = Solid.ExpandBy(UE_KINDA_SMALL_NUMBER);
+	for (int32 Z = Box.Min.Z; Z <= Box.Max.Z; Z++)
+	{
+		for (int32 Y = Box.Min.Y; Y <= Box.Max.Y; Y++)
+		{
+			for (int32 X = Box.Min.X; X <= Box.Max.X; X++)
+			{
+				const FVector CellCenter = GridOrigin + (FVector(X, Y, Z) + 0.5f) * CellSize;
+				if (Inside.IsInsideOrOn(Transform.InverseTransformPosition(CellCenter)))
+				{
+					OutCells.Cells.Add(ToIndex(X, Y, Z));
+				}
+			}
+		}
+	}
+	return OutCells.Cells.Num() > 0;
+}
+
+UOcclusionGridSubsystem::FCellBox UOcclusionGridSubsystem::RasterizeTouching(const FBox& Bounds) const
+{
+	FCellBox Box;
+	if (!Bounds.IsValid) return Box;
+
+	const FVector Lo = (Bounds.Min - GridOrigin) / CellSize;
+	const FVector Hi = (Bounds.Max - GridOrigin) / CellSize;
+	Box.Min = FIntVector(FMath::FloorToInt(Lo.X), FMath::FloorToInt(Lo.Y), FMath::FloorToInt(Lo.Z));
+	Box.Max = FIntVector(FMath::FloorToInt(Hi.X), FMath::FloorToInt(Hi.Y), FMath::FloorToInt(Hi.Z));
+	return Box;
+}
+
+void UOcclusionGridSubsystem::AddToCells(const FBlockerCells& Blocker, int32 Delta)
+{
+	if (Blocker.Cells.Num() > 0)
+	{
+		for (int32 Index : Blocker.Cells)
+		{
+			checkSlow((int32)Counts[Index] + Delta >= 0 && (int32)Counts[Index] + Delta <= MAX_uint16);
+			Counts[Index] = (uint16)(Counts[Index] + Delta);
+		}
+		return;
+	}
+
+	const FCellBox& Box = Blocker.Box;
+	for (int32 Z = Box.Min.Z; Z <= Box.Max.Z; Z++)
+	{
+		for (int32 Y = Box.Min.Y; Y <= Box.Max.Y; Y++)
+		{
+			uint16* Row = &Counts[ToIndex(0, Y, Z)];
+			for (int32 X = Box.Min.X; X <= Box.Max.X; X++)
+			{
+				checkSlow((int32)Row[X] + Delta >= 0 && (int32)Row[X] + Delta <= MAX_uint16);
+				Row[X] = (uint16)(Row[X] + Delta);
+			}
+		}
+	}
+}
+
+void UOcclusionGridSubsystem::AddBlocker(const UObject* Owner, uint32 Id, const FBox& LocalBounds, const FTransform& Transform)
+{
+	if (!Owner || !LocalBounds.IsValid || Counts.Num() == 0) return;
+
+	// Re-adding (e.g. settled again somewhere else) replaces the old footprint
+	RemoveBlocker(Owner, Id);
+
+	FBlockerCells Cells;
+	if (!RasterizeSolid(LocalBounds, Transform, Cells)) return;
+
+	AddToCells(Cells, 1);
+	Blockers.Add(FBlockerKey{ FObjectKey(Owner), Id }, MoveTemp(Cells));
+}
+
+void UOcclusionGridSubsystem::RemoveBlocker(const UObject* Owner, uint32 Id)
+{
+	FBlockerCells Cells;
+	if (Blockers.RemoveAndCopyValue(FBlockerKey{ FObjectKey(Owner), Id }, Cells))
+	{
+		AddToCells(Cells, -1);
+	}
+}
+
+void UOcclusionGridSubsystem::AddComponent(UPrimitiveComponent* Component)
+{
+	if (!Component) return;
+
+	// Large static geometry (walls, buildings) is exactly what should block; only big moving
+	// things are left out, since they would be re-voxelized every time they settle
+	if (Component->Mobility != EComponentMobility::Static && Component->Bounds.GetBox().GetSize().GetMax() > MaxBlockerExtent) return;
+
+	AddBlocker(Component, 0, Component->CalcBounds(FTransform::Identity).GetBox(), Component->GetComponentTransform());
+}
+
+void UOcclusionGridSubsystem::WatchSettling(UPrimitiveComponent* Component)
+{
+	if (!Component) return;
+
+	Component->BodyInstance.bGenerateWakeEvents = true;
+	Component->OnComponentSleep.AddUniqueDynamic(this, &UOcclusionGridSubsystem::HandleSleep);
+	Component->OnComponentWake.AddUniqueDynamic(this, &UOcclusionGridSubsystem::HandleWake);
+}
+
+void UOcclusionGridSubsystem::HandleSleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	AddComponent(SleepingComponent);
+}
+
+void UOcclusionGridSubsystem::HandleWake(UPrimitiveComponent* WakingComponent, FName BoneName)
+{
+	RemoveComponent(WakingComponent);
+}
+
+void UOcclusionGridSubsystem::MarchRays4(const FVector (&Starts)[4], const FVector (&Ends)[4], const FCellBox (&Ignore)[4],
+	const FCellBox& SourceIgnore, int32 NumRaysInBatch, bool (&OutBlocked)[4]) const
+{
+	// Structure of arrays, one lane per ray: [axis][lane]
+	alignas(16) float Cell[3][4];
+	alignas(16) float Step[3][4];
+	alignas(16) float TMax[3][4];
+	alignas(16) float TDelta[3][4];
+	bool bActive[4];
+
+	for (int32 Lane = 0; Lane < 4; Lane++)
+	{
+		// Unused lanes repeat ray 0 and are never read back
+		const int32 Ray = Lane < NumRaysInBatch ? Lane : 0;
+		const FVector Dir = Ends[Ray] - Starts[Ray];
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			const float Start = Starts[Ray][Axis];
+			Cell[Axis][Lane] = FMath::FloorToFloat(Start);
+			if (FMath::Abs(Dir[Axis]) < UE_KINDA_SMALL_NUMBER)
+			{
+				Step[Axis][Lane] = 0.f;
+				TMax[Axis][Lane] = MAX_flt;
+				TDelta[Axis][Lane] = 0.f;
+			}
+			else
+			{
+				Step[Axis][Lane] = Dir[Axis] > 0.f ? 1.f : -1.f;
+				TMax[Axis][Lane] = (Cell[Axis][Lane] + (Dir[Axis] > 0.f ? 1.f : 0.f) - Start) / Dir[Axis];
+				TDelta[Axis][Lane] = FMath::Abs(1.f / Dir[Axis]);
+			}
+		}
+		OutBlocked[Lane] = false;
+		bActive[Lane] = Lane < NumRaysInBatch;
+	}
+
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float One = VectorOneFloat();
+	VectorRegister4Float CX = VectorLoadAligned(Cell[0]), CY = VectorLoadAligned(Cell[1]), CZ = VectorLoadAligned(Cell[2]);
+	VectorRegister4Float TX = VectorLoadAligned(TMax[0]), TY = VectorLoadAligned(TMax[1]), TZ = VectorLoadAligned(TMax[2]);
+	const VectorRegister4Float SX = VectorLoadAligned(Step[0]), SY = VectorLoadAligned(Step[1]), SZ = VectorLoadAligned(Step[2]);
+	const VectorRegister4Float DX = VectorLoadAligned(TDelta[0]), DY = VectorLoadAligned(TDelta[1]), DZ = VectorLoadAligned(TDelta[2]);
+
+	// The start cell is never tested - the blast source sits in it
+	const int32 MaxSteps = SizeX + SizeY + SizeZ;
+	for (int32 Iteration = 0; Iteration < MaxSteps; Iteration++)
+	{
+		// Each lane crosses whichever cell boundary is nearest along its ray
+		const VectorRegister4Float MaskX = VectorBitwiseAnd(VectorCompareLE(TX, TY), VectorCompareLE(TX, TZ));
+		const VectorRegister4Float MaskY = VectorSelect(MaskX, Zero, VectorCompareLE(TY, TZ));
+		const VectorRegister4Float MaskXY = VectorBitwiseOr(MaskX, MaskY);
+		const VectorRegister4Float TEnter = VectorSelect(MaskX, TX, VectorSelect(MaskY, TY, TZ));
+
+		CX = VectorAdd(CX, VectorSelect(MaskX, SX, Zero));
+		TX = VectorAdd(TX, VectorSelect(MaskX, DX, Zero));
+		CY = VectorAdd(CY, VectorSelect(MaskY, SY, Zero));
+		TY = VectorAdd(TY, VectorSelect(MaskY, DY, Zero));
+		CZ = VectorAdd(CZ, VectorSelect(MaskXY, Zero, SZ));
+		TZ = VectorAdd(TZ, VectorSelect(MaskXY, Zero, DZ));
+
+		// Entered past the end point - that ray reached its target
+		const int32 Finished = VectorMaskBits(VectorCompareGE(TEnter, One));
+
+		VectorStoreAligned(CX, Cell[0]);
+		VectorStoreAligned(CY, Cell[1]);
+		VectorStoreAligned(CZ, Cell[2]);
+
+		// Occupancy is a gather, done per lane
+		bool bAnyActive = false;
+		for (int32 Lane = 0; Lane < NumRaysInBatch; Lane++)
+		{
+			if (!bActive[Lane]) continue;
+			if (Finished & (1 << Lane))
+			{
+				bActive[Lane] = false;
+				continue;
+			}
+
+			const int32 X = (int32)Cell[0][Lane];
+			const int32 Y = (int32)Cell[1][Lane];
+			const int32 Z = (int32)Cell[2][Lane];
+			const bool bInGrid = X >= 0 && Y >= 0 && Z >= 0 && X < SizeX && Y < SizeY && Z < SizeZ;
+			if (bInGrid && Counts[ToIndex(X, Y, Z)] != 0 && !Ignore[Lane].Contains(X, Y, Z) && !SourceIgnore.Contains(X, Y, Z))
+			{
+				OutBlocked[Lane] = true;
+				bActive[Lane] = false;
+				continue;
+			}
+			bAnyActive = true;
+		}
+		if (!bAnyActive) break;
+	}
+}
+
+bool UOcclusionGridSubsystem::IsInGrid(const FVector& Location) const
+{
+	const FVector Local = (Location - GridOrigin) / CellSize;
+	return Local.X >= 0.f && Local.Y >= 0.f && Local.Z >= 0.f && Local.X < SizeX && Local.Y < SizeY && Local.Z < SizeZ;
+}
+
+void UOcclusionGridSubsystem::TestVisibility(const FVector& From, const FBox& SourceBox, TArrayView<const FVector> Targets,
+	TArrayView<const FBox> TargetBoxes, TBitArray<>& OutVisible, TBitArray<>& OutOutsideGrid) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_OcclusionMarch);
+
+	OutVisible.Init(true, Targets.Num());
+
+	// The grid is convex, so a segment with both ends inside never leaves it. Anything else
+	// would pass through unvoxelized space as if it were open - leave those to a trace.
+	const bool bFromInGrid = Counts.Num() > 0 && IsInGrid(From);
+	OutOutsideGrid.Init(!bFromInGrid, Targets.Num());
+	if (!bFromInGrid)
+	{
+		NumOutsideGrid += Targets.Num();
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<64>> Inside;
+	for (int32 i = 0; i < Targets.Num(); i++)
+	{
+		if (IsInGrid(Targets[i]))
+		{
+			Inside.Add(i);
+		}
+		else
+		{
+			OutOutsideGrid[i] = true;
+			NumOutsideGrid++;
+		}
+	}
+
+	const FCellBox SourceIgnore = RasterizeTouching(SourceBox);
+	const FVector Start = (From - GridOrigin) / CellSize;
+
+	FVector Starts[4] = { Start, Start, Start, Start };
+	FVector Ends[4];
+	FCellBox Ignore[4];
+	bool bBlocked[4];
+
+	for (int32 First = 0; First < Inside.Num(); First += 4)
+	{
+		const int32 NumInBatch = FMath::Min(4, Inside.Num() - First);
+		for (int32 Lane = 0; Lane < NumInBatch; Lane++)
+		{
+			const int32 Target = Inside[First + Lane];
+			Ends[Lane] = (Targets[Target] - GridOrigin) / CellSize;
+			Ignore[Lane] = RasterizeTouching(TargetBoxes[Target]);
+		}
+
+		MarchRays4(Starts, Ends, Ignore, SourceIgnore, NumInBatch, bBlocked);
+
+		for (int32 Lane = 0; Lane < NumInBatch; Lane++)
+		{
+			if (bBlocked[Lane])
+			{
+				OutVisible[Inside[First + Lane]] = false;
+				NumBlocked++;
+			}
+		}
+	}
+	NumRays += Inside.Num();
+}
+
+void UOcclusionGridSubsystem::ApplyRadialDamage(float BaseDamage, const FVector& Origin, float Radius, AActor* DamageCauser,
+	AController* Instigator, const TArray<AActor*>& IgnoreActors)
+{
+	SCOPE_CYCLE_COUNTER(STAT_OcclusionRadialDamage);
+
+	UWorld* World = GetWorld();
+	if (!World || Radius <= 0.f) return;
+
+	FCollisionQueryParams SphereParams(SCENE_QUERY_STAT(ApplyRadialDamage), false, DamageCauser);
+	SphereParams.AddIgnoredActors(IgnoreActors);
+
+	TArray<FOverlapResult> Overlaps;
+	World->OverlapMultiByObjectType(Overlaps, Origin, FQuat::Identity,
+		FCollisionObjectQueryParams(FCollisionObjectQueryParams::InitType::AllDynamicObjects),
+		FCollisionShape::MakeSphere(Radius), SphereParams);
+
+	// One line-of-sight test per component, aimed at its bounds center like UGameplayStatics
+	TArray<UPrimitiveComponent*, TInlineAllocator<64>> Candidates;
+	TArray<FVector, TInlineAllocator<64>> Centers;
+	TArray<FBox, TInlineAllocator<64>> Boxes;
+	TArray<int32, TInlineAllocator<64>> Items;
+	TSet<UPrimitiveComponent*> Seen;
+	for (const FOverlapResult& Overlap : Overlaps)
+	{
+		UPrimitiveComponent* Component = Overlap.GetComponent();
+		if (!Component || !Overlap.GetActor() || Seen.Contains(Component)) continue;
+		Seen.Add(Component);
+
+		Candidates.Add(Component);
+		Centers.Add(Component->Bounds.Origin);
+		Boxes.Add(Component->Bounds.GetBox());
+		Items.Add(Overlap.ItemIndex);
+	}
+	if (Candidates.Num() == 0) return;
+
+	TBitArray<> Visible;
+	TBitArray<> OutsideGrid;
+	if (Mode != EMode::Trace)
+	{
+		const FBox SourceBox = DamageCauser ? DamageCauser->GetComponentsBoundingBox() : FBox(ForceInit);
+		TestVisibility(Origin, SourceBox, Centers, Boxes, Visible, OutsideGrid);
+	}
+	else
+	{
+		Visible.Init(true, Candidates.Num());
+		OutsideGrid.Init(true, Candidates.Num());
+	}
+
+	// Trace mode and Validate trace everything; Grid mode only what the grid doesn't cover
+	FCollisionQueryParams LineParams(SCENE_QUERY_STAT(ComponentIsVisibleFrom), true, DamageCauser);
+	LineParams.AddIgnoredActors(IgnoreActors);
+	for (int32 i = 0; i < Candidates.Num(); i++)
+	{
+		if (Mode == EMode::Grid && !OutsideGrid[i]) continue;
+
+		FHitResult Hit;
+		const bool bTraceVisible = !World->LineTraceSingleByChannel(Hit, Origin, Centers[i], ECC_Visibility, LineParams)
+			|| Hit.Component == Candidates[i];
+		if (Mode == EMode::Validate && !OutsideGrid[i] && bTraceVisible != Visible[i])
+		{
+			NumMismatches++;
+		}
+		Visible[i] = bTraceVisible;
+	}
+
+	// Group the visible components per actor - each actor takes the damage once
+	TMap<AActor*, TArray<FHitResult>> VictimHits;
+	for (int32 i = 0; i < Candidates.Num(); i++)
+	{
+		if (!Visible[i]) continue;
+
+		AActor* Victim = Candidates[i]->GetOwner();
+		FHitResult Hit(Victim, Candidates[i], Centers[i], (Origin - Centers[i]).GetSafeNormal());
+		Hit.ImpactPoint = Centers[i];
+		Hit.Item = Items[i];
+		VictimHits.FindOrAdd(Victim).Add(Hit);
+	}
+
+	for (const TPair<AActor*, TArray<FHitResult>>& Pair : VictimHits)
+	{
+		// Earlier victims can chain-destroy later ones
+		if (!IsValid(Pair.Key)) continue;
+
+		FRadialDamageEvent DamageEvent;
+		DamageEvent.DamageTypeClass = UDamageType::StaticClass();
+		DamageEvent.Origin = Origin;
+		DamageEvent.Params = FRadialDamageParams(BaseDamage, BaseDamage, Radius, Radius, 1.f);
+		DamageEvent.ComponentHits = Pair.Value;
+		Pair.Key->TakeDamage(BaseDamage, DamageEvent, Instigator, DamageCauser);
+	}
+}
+
+void UOcclusionGridSubsystem::DumpToLog() const
+{
+	static const TCHAR* ModeNames[] = { TEXT("Grid"), TEXT("Trace"), TEXT("Validate") };
+
+	int32 Occupied = 0;
+	for (uint16 Count : Counts)
+	{
+		Occupied += Count != 0;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Occlusion: mode %s, %d blockers, %d/%d cells occupied"),
+		ModeNames[(int32)Mode], Blockers.Num(), Occupied, Counts.Num());
+	UE_LOG(LogTemp, Display, TEXT("  %lld rays marched, %lld blocked, %lld left the grid (traced), %lld grid/trace disagreements"),
+		NumRays, NumBlocked, NumOutsideGrid, NumMismatches);
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "OcclusionGridSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+/**
+ * Coarse occupancy voxels of things that block explosions - static level geometry, intact
+ * destructibles, field instances and debris that has gone to sleep. Blockers are added and
+ * removed incrementally as objects break or settle; each cell keeps a count so overlapping
+ * blockers can come and go independently.
+ *
+ * Radial damage line of sight is answered by marching four rays at a time through the grid
+ * (3D DDA) instead of one physics trace per candidate component. The grid is a fixed box around
+ * the origin (GridCells x CellSize); rays with an end outside it fall back to a physics trace.
+ * Exact traces remain available for comparison.
+ *
+ * Console: Sandbox.Occlusion [Grid|Trace|Validate]
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UOcclusionGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	enum class EMode : uint8
+	{
+		Grid,      // Voxel march only
+		Trace,     // Physics traces only (previous behaviour)
+		Validate   // Both - traces decide, disagreements are counted
+	};
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	// A blocker is identified by its owner object plus an ID (0 for whole components, instance IDs for fields).
+	// LocalBounds is placed by Transform, so rotated blockers fill the cells they actually cover.
+	void AddBlocker(const UObject* Owner, uint32 Id, const FBox& LocalBounds, const FTransform& Transform);
+	void RemoveBlocker(const UObject* Owner, uint32 Id);
+
+	void AddComponent(UPrimitiveComponent* Component);
+	void RemoveComponent(UPrimitiveComponent* Component) { RemoveBlocker(Component, 0); }
+
+	// Simulating debris - becomes a blocker while asleep
+	void WatchSettling(UPrimitiveComponent* Component);
+
+	// Drop-in for UGameplayStatics::ApplyRadialDamage with full damage and ECC_Visibility prevention
+	void ApplyRadialDamage(float BaseDamage, const FVector& Origin, float Radius, AActor* DamageCauser,
+		AController* Instigator, const TArray<AActor*>& IgnoreActors);
+
+	// For each target, is the segment From -> Target free of blockers outside its own box and SourceBox.
+	// Segments with an end outside the grid are not marched: OutOutsideGrid is set and OutVisible
+	// left true for them, and the caller has to trace them.
+	void TestVisibility(const FVector& From, const FBox& SourceBox, TArrayView<const FVector> Targets,
+		TArrayView<const FBox> TargetBoxes, TBitArray<>& OutVisible, TBitArray<>& OutOutsideGrid) const;
+
+	bool IsInGrid(const FVector& Location) const;
+
+	void SetMode(EMode InMode) { Mode = InMode; }
+	void DumpToLog() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FCellBox
+	{
+		FIntVector Min = FIntVector(0);
+		FIntVector Max = FIntVector(-1);
+
+		bool IsEmpty() const { return Max.X < Min.X || Max.Y < Min.Y || Max.Z < Min.Z; }
+		bool Contains(int32 X, int32 Y, int32 Z) const
+		{
+			return X >= Min.X && X <= Max.X && Y >= Min.Y && Y <= Max.Y && Z >= Min.Z && Z <= Max.Z;
+		}
+	};
+
+	struct FBlockerCells
+	{
+		FCellBox Box;          // Cell range of the blocker's world bounds
+		TArray<int32> Cells;   // Filled cells of a rotated blocker; empty means all of Box
+	};
+
+	// Cells whose centers lie inside the placed box (what the blocker fills). False if it fills nothing.
+	bool RasterizeSolid(const FBox& LocalBounds, const FTransform& Transform, FBlockerCells& OutCells) const;
+	// Every cell Bounds touches (what a ray may pass through without being blocked)
+	FCellBox RasterizeTouching(const FBox& Bounds) const;
+
+	void AddToCells(const FBlockerCells& Blocker, int32 Delta);
+	int32 ToIndex(int32 X, int32 Y, int32 Z) const { return (Z * SizeY + Y) * SizeX + X; }
+
+	// Four rays in grid space; OutBlocked[i] set when ray i hits an occupied cell
+	void MarchRays4(const FVector (&Starts)[4], const FVector (&Ends)[4], const FCellBox (&Ignore)[4],
+		const FCellBox& SourceIgnore, int32 NumRaysInBatch, bool (&OutBlocked)[4]) const;
+
+	UFUNCTION()
+	void HandleSleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+
+	UFUNCTION()
+	void HandleWake(UPrimitiveComponent* WakingComponent, FName BoneName);
+
+	// === CONFIG (DefaultGame.ini) ===
+	UPROPERTY(Config)
+	float CellSize = 100.f;
+
+	// Cells per side in XY, grid is centered on the world origin
+	UPROPERTY(Config)
+	int32 GridCells = 256;
+
+	UPROPERTY(Config)
+	int32 HeightCells = 24;
+
+	// World Z of the bottom of the grid
+	UPROPERTY(Config)
+	float GridMinZ = -400.f;
+
+	// Moving blockers larger than this are not voxelized; static geometry always is
+	UPROPERTY(Config)
+	float MaxBlockerExtent = 1500.f;
+
+	// Blockers thinner than a cell on some axis are thickened to one cell on that axis,
+	// as long as they are at least this thick
+	UPROPERTY(Config)
+	float MinBlockerSize = 40.f;
+
+	EMode Mode = EMode::Grid;
+
+	FVector GridOrigin = FVector::ZeroVector;  // World position of cell (0,0,0)'s corner
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	int32 SizeZ = 0;
+
+	// Blockers overlapping each cell
+	TArray<uint16> Counts;
+
+	struct FBlockerKey
+	{
+		FObjectKey Owner;
+		uint32 Id = 0;
+
+		bool operator==(const FBlockerKey& Other) const { return Owner == Other.Owner && Id == Other.Id; }
+		friend uint32 GetTypeHash(const FBlockerKey& Key) { return HashCombine(GetTypeHash(Key.Owner), Key.Id); }
+	};
+	TMap<FBlockerKey, FBlockerCells> Blockers;
+
+	// Running totals for Sandbox.Occlusion
+	mutable int64 NumRays = 0;
+	mutable int64 NumBlocked = 0;
+	mutable int64 NumOutsideGrid = 0;
+	int64 NumMismatches = 0;
+};
@@ -0,0 +1,153 @@
+#include "ProjectilePoolSubsystem.h"
+#include "Projectiles/TankProjectile.h"
+#include "Engine/World.h"
+#include "NiagaraComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+
+bool UProjectilePoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UProjectilePoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	Free.Reserve(MaxPooledProjectiles);
+	Effects.Reserve(MaxEffects);
+
+	for (int32 i = 0; i < FMath::Min(PrewarmProjectiles, MaxPooledProjectiles); i++)
+	{
+		if (ATankProjectile* Projectile = SpawnProjectile(nullptr, FVector::ZeroVector, FRotator::ZeroRotator))
+		{
+			Projectile->Park();
+			Free.Add(Projectile);
+		}
+	}
+}
+
+void UProjectilePoolSubsystem::Deinitialize()
+{
+	for (const FTimedEffect& Effect : Effects)
+	{
+		RetireEffect(Effect.Component.Get());
+	}
+	Effects.Reset();
+	Free.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UProjectilePoolSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectilePoolSubsystem, STATGROUP_Tickables);
+}
+
+ATankProjectile* UProjectilePoolSubsystem::SpawnProjectile(AActor* Shooter, const FVector& Location, const FRotator& Rotation)
+{
+	UWorld* World = GetWorld();
+	if (!World) return nullptr;
+
+	FActorSpawnParameters Params;
+	Params.Owner = Shooter;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	return World->SpawnActor<ATankProjectile>(ATankProjectile::StaticClass(), Location, Rotation, Params);
+}
+
+ATankProjectile* UProjectilePoolSubsystem::Acquire(AActor* Shooter, const FVector& Location, const FRotator& Rotation, uint32 ShotId)
+{
+	ATankProjectile* Projectile = nullptr;
+	while (!Projectile && Free.Num() > 0)
+	{
+		Projectile = Free.Pop(EAllowShrinking::No);
+		if (!IsValid(Projectile))
+		{
+			Projectile = nullptr;
+		}
+	}
+
+	if (!Projectile)
+	{
+		Projectile = SpawnProjectile(Shooter, Location, Rotation);
+		if (!Projectile) return nullptr;
+	}
+
+	Projectile->Launch(Shooter, Location, Rotation, ShotId);
+	return Projectile;
+}
+
+void UProjectilePoolSubsystem::Release(ATankProjectile* Projectile)
+{
+	if (!IsValid(Projectile)) return;
+
+	if (Free.Num() >= MaxPooledProjectiles)
+	{
+		Projectile->Destroy();
+		return;
+	}
+
+	Projectile->Park();
+	Free.Add(Projectile);
+}
+
+void UProjectilePoolSubsystem::SpawnEffect(UNiagaraSystem* System, const FVector& Location, const FVector& Scale, float Duration)
+{
+	UWorld* World = GetWorld();
+	if (!System || !World || MaxEffects <= 0) return;
+
+	// Full - let the oldest one go early rather than grow
+	if (Effects.Num() >= MaxEffects)
+	{
+		RetireEffect(Effects[0].Component.Get());
+		Effects.RemoveAt(0, 1, EAllowShrinking::No);
+	}
+
+	UNiagaraComponent* Component = UNiagaraFunctionLibrary::SpawnSystemAtLocation(
+		World, System, Location, FRotator::ZeroRotator, Scale,
+		false, true, ENCPoolMethod::ManualRelease);
+	if (!Component) return;
+
+	FTimedEffect& Effect = Effects.AddDefaulted_GetRef();
+	Effect.Component = Component;
+	Effect.ExpireTime = World->GetTimeSeconds() + Duration;
+}
+
+void UProjectilePoolSubsystem::RetireEffect(UNiagaraComponent* Component)
+{
+	if (!Component) return;
+
+	// Soft deactivate - Niagara reclaims it once the remaining particles finish
+	Component->Deactivate();
+	Component->ReleaseToPool();
+}
+
+void UProjectilePoolSubsystem::Tick(float DeltaTime)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Parked shells cost the replication graph nothing once dormant, but only after the
+	// hide has had a few net updates to reach clients
+	const double DormantBefore = Now - ParkDormancyDelay;
+	for (ATankProjectile* Projectile : Free)
+	{
+		if (IsValid(Projectile) && Projectile->NetDormancy == DORM_Awake && Projectile->GetParkTime() <= DormantBefore)
+		{
+			Projectile->SetNetDormancy(DORM_DormantAll);
+		}
+	}
+
+	if (Effects.Num() == 0) return;
+
+	// Added in spawn order, and most share a duration, so expired ones sit at the front
+	int32 NumExpired = 0;
+	while (NumExpired < Effects.Num() && Effects[NumExpired].ExpireTime <= Now)
+	{
+		RetireEffect(Effects[NumExpired].Component.Get());
+		NumExpired++;
+	}
+	if (NumExpired > 0)
+	{
+		Effects.RemoveAt(0, NumExpired, EAllowShrinking::No);
+	}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ProjectilePoolSubsystem.generated.h"
+
+class ATankProjectile;
+class UNiagaraComponent;
+class UNiagaraSystem;
+
+/**
+ * Keeps the shell fire -> fly -> explode path off the heap.
+ * Shells are parked and relaunched instead of spawned and destroyed, and explosion
+ * effects come from Niagara's world pool and are released here on a timer, so a
+ * steady-state shot creates no actors, components or timer delegates.
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UProjectilePoolSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Reuse a parked shell (or spawn one if the pool is dry) and send it on its way
+	ATankProjectile* Acquire(AActor* Shooter, const FVector& Location, const FRotator& Rotation, uint32 ShotId);
+
+	// Shell finished its flight - park it for the next shot
+	void Release(ATankProjectile* Projectile);
+
+	// Spawn a pooled one-shot effect that is deactivated and returned to Niagara's pool after Duration
+	void SpawnEffect(UNiagaraSystem* System, const FVector& Location, const FVector& Scale, float Duration);
+
+	int32 GetNumFree() const { return Free.Num(); }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	ATankProjectile* SpawnProjectile(AActor* Shooter, const FVector& Location, const FRotator& Rotation);
+	static void RetireEffect(UNiagaraComponent* Component);
+
+	// === CONFIG (DefaultGame.ini) ===
+	// Shells created up front so the first volleys don't spawn
+	UPROPERTY(Config)
+	int32 PrewarmProjectiles = 8;
+
+	// Parked shells beyond this are destroyed
+	UPROPERTY(Config)
+	int32 MaxPooledProjectiles = 64;
+
+	// Seconds a shell stays parked before going net dormant, so its hidden state replicates first
+	UPROPERTY(Config)
+	float ParkDormancyDelay = 0.5f;
+
+	// Oldest effect is released early when this many are live
+	UPROPERTY(Config)
+	int32 MaxEffects = 32;
+
+	UPROPERTY()
+	TArray<ATankProjectile*> Free;
+
+	struct FTimedEffect
+	{
+		TWeakObjectPtr<UNiagaraComponent> Component;
+		double ExpireTime = 0.0;
+	};
+	TArray<FTimedEffect> Effects;
+};
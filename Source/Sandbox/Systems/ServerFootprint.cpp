@@ -0,0 +1,86 @@
+#include "Sandbox.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectHash.h"
+#include "Pawns/TankPawn.h"
+#include "Destructibles/DestructibleTarget.h"
+
+/**
+ * Per-actor object count and memory for tanks and destructibles, to compare a
+ * client against a dedicated server (where cosmetic subobjects are never created).
+ * Pair with "stat game" for the TankPawn Tick cost.
+ *
+ * With a label, each line is also appended to Saved/Footprint.csv so runs of the
+ * Sandbox and SandboxServer targets can be compared side by side.
+ */
+template <typename ActorType>
+static void LogFootprint(UWorld* World, const TCHAR* Label, FString* CsvOut)
+{
+	int32 NumActors = 0;
+	int64 NumObjects = 0;
+	int64 Bytes = 0;
+
+	for (TActorIterator<ActorType> It(World); It; ++It)
+	{
+		NumActors++;
+		NumObjects++;
+		Bytes += It->GetClass()->GetStructureSize() + It->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+
+		// Components, material instances, anything else the actor owns
+		ForEachObjectWithOuter(*It, [&NumObjects, &Bytes](UObject* Object)
+		{
+			NumObjects++;
+			Bytes += Object->GetClass()->GetStructureSize() + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		}, true);
+	}
+
+	if (NumActors == 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("  %-13s none"), Label);
+		if (CsvOut)
+		{
+			*CsvOut += FString::Printf(TEXT(",%s,0,0,0"), Label);
+		}
+		return;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("  %-13s %5d actors  %6.1f objects/actor  %8.1f KB/actor"),
+		Label, NumActors, (double)NumObjects / NumActors, Bytes / 1024.0 / NumActors);
+
+	if (CsvOut)
+	{
+		*CsvOut += FString::Printf(TEXT(",%s,%d,%.1f,%.1f"), Label, NumActors, (double)NumObjects / NumActors, Bytes / 1024.0 / NumActors);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CmdFootprint(
+	TEXT("Sandbox.Footprint"),
+	TEXT("Print objects and memory per tank and per destructible (compare client vs dedicated server). [Label] also appends to Saved/Footprint.csv"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World) return;
+
+		const TCHAR* Mode = Sandbox::IsCosmeticDisabled() ? TEXT("cosmetics stripped") : TEXT("full");
+		FString Csv;
+		FString* CsvOut = Args.Num() > 0 ? &Csv : nullptr;
+		if (CsvOut)
+		{
+			Csv = FString::Printf(TEXT("%s,%s"), *Args[0], Mode);
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Footprint (%s):"), Mode);
+		LogFootprint<ATankPawn>(World, TEXT("Tanks"), CsvOut);
+		LogFootprint<ADestructibleTarget>(World, TEXT("Destructibles"), CsvOut);
+
+		if (CsvOut)
+		{
+			const FString Path = FPaths::ProjectSavedDir() / TEXT("Footprint.csv");
+			FFileHelper::SaveStringToFile(Csv + LINE_TERMINATOR, *Path, FFileHelper::EEncodingOptions::AutoDetect,
+				&IFileManager::Get(), FILEWRITE_Append);
+			UE_LOG(LogTemp, Display, TEXT("  appended to %s"), *Path);
+		}
+	}));
@@ -0,0 +1,174 @@
+#include "ShotAllocationCounter.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformAtomics.h"
+#include <atomic>
+
+namespace ShotAllocationCounter
+{
+	// Nesting depth of FScope on this thread (Explode runs inside Tick's scope)
+	static thread_local int32 ScopeDepth = 0;
+
+	static std::atomic<int64> NumAllocations{0};
+	static int32 NumShots = 0;
+	static bool bRunning = false;
+
+	// Forwards everything to the real allocator, counting Malloc/Realloc calls made inside a scope.
+	// Installed once and never deleted - blocks allocated through it are owned by the inner allocator,
+	// and another thread may still be inside a call when GMalloc is switched back.
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		FMalloc* GetInner() const { return Inner; }
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountCall();
+			return Inner->Malloc(Count, Alignment);
+		}
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountCall();
+			return Inner->TryMalloc(Count, Alignment);
+		}
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountCall();
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			CountCall();
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("ShotAllocationCounter"); }
+
+	private:
+		static void CountCall()
+		{
+			if (ScopeDepth > 0)
+			{
+				NumAllocations.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		FMalloc* Inner;
+	};
+
+	static FCountingMalloc* Proxy = nullptr;
+
+	bool IsRunning()
+	{
+		return bRunning;
+	}
+
+	void NotifyShotFinished()
+	{
+		if (bRunning)
+		{
+			NumShots++;
+		}
+	}
+
+	FScope::FScope()
+	{
+		ScopeDepth++;
+	}
+
+	FScope::~FScope()
+	{
+		ScopeDepth--;
+	}
+
+	// Worker threads allocate through GMalloc the whole time it is being switched, so the
+	// pointer is swapped atomically - a racing call sees either allocator, never a torn value
+	static void InstallMalloc(FMalloc* Malloc)
+	{
+		FPlatformAtomics::InterlockedExchangePtr(reinterpret_cast<void**>(&GMalloc), Malloc);
+	}
+
+	void Start()
+	{
+		if (bRunning) return;
+
+		if (!Proxy)
+		{
+			Proxy = new FCountingMalloc(GMalloc);
+		}
+
+		NumAllocations = 0;
+		NumShots = 0;
+		InstallMalloc(Proxy);
+		bRunning = true;
+	}
+
+	bool Stop(int64& OutAllocations, int32& OutShots)
+	{
+		if (!bRunning) return false;
+
+		InstallMalloc(Proxy->GetInner());
+		bRunning = false;
+
+		OutAllocations = NumAllocations.load();
+		OutShots = NumShots;
+		return true;
+	}
+
+	static void StopAndLog(int32 Budget)
+	{
+		int64 Total = 0;
+		int32 Shots = 0;
+		if (!Stop(Total, Shots)) return;
+
+		if (Shots == 0)
+		{
+			UE_LOG(LogTemp, Display, TEXT("ShotAllocs: no shots finished (%lld allocations)"), Total);
+			return;
+		}
+
+		const double PerShot = (double)Total / Shots;
+		if (PerShot <= Budget)
+		{
+			UE_LOG(LogTemp, Display, TEXT("ShotAllocs: PASS - %lld allocations over %d shots (%.2f/shot, budget %d)"),
+				Total, Shots, PerShot, Budget);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ShotAllocs: FAIL - %lld allocations over %d shots (%.2f/shot, budget %d)"),
+				Total, Shots, PerShot, Budget);
+		}
+	}
+}
+
+static FAutoConsoleCommand CmdShotAllocs(
+	TEXT("Sandbox.ShotAllocs"),
+	TEXT("Count heap allocations per shot. Start | Stop [Budget=4]. Fire a few shells first so pools are warm."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() > 0 && Args[0].Equals(TEXT("Start"), ESearchCase::IgnoreCase))
+		{
+			ShotAllocationCounter::Start();
+			UE_LOG(LogTemp, Display, TEXT("ShotAllocs: counting - fire some shells, then Sandbox.ShotAllocs Stop"));
+		}
+		else if (Args.Num() > 0 && Args[0].Equals(TEXT("Stop"), ESearchCase::IgnoreCase))
+		{
+			ShotAllocationCounter::StopAndLog(Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 4);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Display, TEXT("Usage: Sandbox.ShotAllocs Start | Stop [Budget]"));
+		}
+	}));
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Counts game-thread heap allocations made on the shot hot path (fire -> fly -> explode).
+ * While a measurement runs, GMalloc is wrapped by a forwarding proxy that only counts
+ * calls made inside a SANDBOX_SHOT_ALLOC_SCOPE, so unrelated engine work is excluded.
+ *
+ * Console: Sandbox.ShotAllocs Start, Sandbox.ShotAllocs Stop [Budget]
+ * Automation: Sandbox.Projectiles.ShotAllocations
+ */
+namespace ShotAllocationCounter
+{
+	// Wrap GMalloc and start counting - warm the pools with a few shots first
+	void Start();
+
+	// Restore GMalloc. Returns false if no measurement was running.
+	bool Stop(int64& OutAllocations, int32& OutShots);
+
+	bool IsRunning();
+
+	// A pooled shell finished its flight - the measurement reports allocations per shot
+	void NotifyShotFinished();
+
+	struct FScope
+	{
+		FScope();
+		~FScope();
+	};
+}
+
+#if !UE_BUILD_SHIPPING
+#define SANDBOX_SHOT_ALLOC_SCOPE() ShotAllocationCounter::FScope ANONYMOUS_VARIABLE(ShotAllocScope)
+#else
+#define SANDBOX_SHOT_ALLOC_SCOPE()
+#endif
@@ -0,0 +1,167 @@
+#include "TankSpawnSubsystem.h"
+#include "Pawns/TankPawn.h"
+#include "Pawns/TankBotPawn.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tank Spawn"), STAT_TankSpawn, STATGROUP_Game);
+
+static FAutoConsoleCommandWithWorldAndArgs CmdSpawnTanks(
+	TEXT("Sandbox.SpawnTanks"),
+	TEXT("Spawn a wave of bot tanks around player 0, or print spawn cost with no args. Args: [Count]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UTankSpawnSubsystem* Spawner = World ? World->GetSubsystem<UTankSpawnSubsystem>() : nullptr;
+		if (!Spawner) return;
+
+		const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 0;
+		if (Count <= 0)
+		{
+			Spawner->DumpToLog();
+			return;
+		}
+
+		FVector Center = FVector::ZeroVector;
+		const APlayerController* PC = World->GetFirstPlayerController();
+		if (const APawn* Pawn = PC ? PC->GetPawn() : nullptr)
+		{
+			Center = Pawn->GetActorLocation();
+		}
+
+		// Ring facing inwards, roughly one tank length apart
+		const float Radius = FMath::Max(3000.f, Count * 800.f / (2.f * PI));
+		TArray<FTransform> Transforms;
+		Transforms.Reserve(Count);
+		for (int32 i = 0; i < Count; i++)
+		{
+			const float Angle = 2.f * PI * i / Count;
+			const FVector Location = Center + FVector(FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius, 100.f);
+			Transforms.Emplace(FRotator(0.f, FMath::RadiansToDegrees(Angle) + 180.f, 0.f), Location);
+		}
+		Spawner->SpawnTanks(ATankBotPawn::StaticClass(), Transforms);
+	}));
+
+bool UTankSpawnSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTankSpawnSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTankSpawnSubsystem, STATGROUP_Tickables);
+}
+
+void UTankSpawnSubsystem::Deinitialize()
+{
+	Pending.Reset();
+	NextPending = 0;
+	Deferred.Reset();
+	NextDeferred = 0;
+	Super::Deinitialize();
+}
+
+void UTankSpawnSubsystem::SpawnTanks(TSubclassOf<ATankPawn> Class, TArrayView<const FTransform> Transforms, bool bSpawnControllers)
+{
+	if (!Class || GetWorld()->GetNetMode() == NM_Client) return;
+
+	Pending.Reserve(Pending.Num() + Transforms.Num());
+	for (const FTransform& Transform : Transforms)
+	{
+		Pending.Add({ Class, Transform, bSpawnControllers });
+	}
+}
+
+void UTankSpawnSubsystem::Tick(float DeltaTime)
+{
+	if (NextDeferred >= Deferred.Num() && NextPending >= Pending.Num()) return;
+
+	SCOPE_CYCLE_COUNTER(STAT_TankSpawn);
+
+	// One budget for the frame, shared by finishing and construction
+	const double StartTime = FPlatformTime::Seconds();
+	const double Deadline = StartTime + MaxSpawnMilliseconds * 0.001;
+
+	// Earlier frames' tanks first, so a tank is never constructed and initialized in the same frame
+	FinishDeferred(Deadline);
+	ConstructPending(Deadline);
+
+	PeakFrameSeconds = FMath::Max(PeakFrameSeconds, FPlatformTime::Seconds() - StartTime);
+}
+
+void UTankSpawnSubsystem::FinishDeferred(double Deadline)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Everything queued so far was constructed in an earlier frame
+	for (int32 Count = 0; NextDeferred < Deferred.Num() && Count < FMath::Max(1, MaxSpawnsPerFrame); Count++)
+	{
+		if (Count > 0 && FPlatformTime::Seconds() >= Deadline) break;
+
+		const FDeferredTank& Entry = Deferred[NextDeferred++];
+		ATankPawn* Tank = Entry.Tank.Get();
+		if (!Tank)
+		{
+			NumFailed++;
+			continue;
+		}
+
+		Tank->FinishSpawning(Entry.Transform);
+		if (Entry.bSpawnController && !Tank->GetController())
+		{
+			Tank->SpawnDefaultController();
+		}
+		NumSpawned++;
+	}
+
+	if (NextDeferred >= Deferred.Num())
+	{
+		Deferred.Reset();
+		NextDeferred = 0;
+	}
+
+	FinishSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+void UTankSpawnSubsystem::ConstructPending(double Deadline)
+{
+	UWorld* World = GetWorld();
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 Count = 0; NextPending < Pending.Num() && Count < FMath::Max(1, MaxSpawnsPerFrame); Count++)
+	{
+		if (Count > 0 && FPlatformTime::Seconds() >= Deadline) break;
+
+		const FPendingSpawn& Spawn = Pending[NextPending++];
+
+		// Subobjects are instanced from the class default object and the native components registered;
+		// initialization (treads), BeginPlay and the controller wait for FinishDeferred
+		ATankPawn* Tank = World->SpawnActorDeferred<ATankPawn>(Spawn.Class, Spawn.Transform, nullptr, nullptr,
+			ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		if (!Tank)
+		{
+			NumFailed++;
+			continue;
+		}
+		Deferred.Add({ Tank, Spawn.Transform, Spawn.bSpawnController });
+	}
+
+	if (NextPending >= Pending.Num())
+	{
+		Pending.Reset();
+		NextPending = 0;
+	}
+
+	ConstructSeconds += FPlatformTime::Seconds() - StartTime;
+}
+
+void UTankSpawnSubsystem::DumpToLog() const
+{
+	const double PerTank = NumSpawned > 0 ? 1000.0 / NumSpawned : 0.0;
+	UE_LOG(LogTemp, Display, TEXT("TankSpawn: %lld spawned (%lld failed), %d pending - %.3f ms/tank (construct %.3f, finish %.3f), peak frame %.2f ms"),
+		NumSpawned, NumFailed, GetNumPending(),
+		(ConstructSeconds + FinishSeconds) * PerTank, ConstructSeconds * PerTank, FinishSeconds * PerTank,
+		PeakFrameSeconds * 1000.0);
+}
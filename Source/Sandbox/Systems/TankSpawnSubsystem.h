@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Templates/SubclassOf.h"
+#include "TankSpawnSubsystem.generated.h"
+
+class ATankPawn;
+
+/**
+ * Spawns waves of tanks without a hitch.
+ * Requests are queued and worked off a few per frame: each tank is constructed deferred in one
+ * frame (object and native components created and registered, physics bodies included) and
+ * finished in a later one (component initialization - which builds the tank body's treads and
+ * material instances - BeginPlay and the controller), both under the same per-frame budget, so a
+ * wave of fifty costs a slice of several frames rather than one long one. This spreads the cost; it does not reduce it - each tank is still built
+ * from its class default object like any other spawn. Use ATankBotPawn for bots: skipping the
+ * spring arm and camera is the one per-tank saving.
+ *
+ * Console: Sandbox.SpawnTanks [Count]
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UTankSpawnSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Queue tanks at the given transforms (server only)
+	void SpawnTanks(TSubclassOf<ATankPawn> Class, TArrayView<const FTransform> Transforms, bool bSpawnControllers = true);
+
+	int32 GetNumPending() const { return Pending.Num() - NextPending + Deferred.Num() - NextDeferred; }
+
+	void DumpToLog() const;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	struct FPendingSpawn
+	{
+		TSubclassOf<ATankPawn> Class;
+		FTransform Transform;
+		bool bSpawnController = true;
+	};
+
+	struct FDeferredTank
+	{
+		TWeakObjectPtr<ATankPawn> Tank;
+		FTransform Transform;
+		bool bSpawnController = true;
+	};
+
+	// Both stop once Deadline (FPlatformTime::Seconds) has passed, after at least one tank
+	void FinishDeferred(double Deadline);
+	void ConstructPending(double Deadline);
+
+	// === CONFIG (DefaultGame.ini) ===
+	// Tanks constructed, and tanks finished, per frame (at least one of each always goes)
+	UPROPERTY(Config)
+	int32 MaxSpawnsPerFrame = 8;
+
+	// Finishing and construction stop early once this frame's spawning has taken this long
+	UPROPERTY(Config)
+	float MaxSpawnMilliseconds = 3.f;
+
+	TArray<FPendingSpawn> Pending;
+	int32 NextPending = 0;
+	TArray<FDeferredTank> Deferred;
+	int32 NextDeferred = 0;
+
+	// Running totals for Sandbox.SpawnTanks
+	int64 NumSpawned = 0;
+	int64 NumFailed = 0;
+	double ConstructSeconds = 0.0;
+	double FinishSeconds = 0.0;
+	double PeakFrameSeconds = 0.0;
+};
@@ -0,0 +1,50 @@
+#include "TankSuspensionSubsystem.h"
+#include "Components/TankSuspensionComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Suspension Consume"), STAT_SuspensionConsume, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("Suspension Issue"), STAT_SuspensionIssue, STATGROUP_Game);
+
+void UTankSuspensionSubsystem::Register(UTankSuspensionComponent* Suspension)
+{
+	if (Suspension)
+	{
+		Suspensions.AddUnique(Suspension);
+	}
+}
+
+void UTankSuspensionSubsystem::Unregister(UTankSuspensionComponent* Suspension)
+{
+	Suspensions.RemoveSingleSwap(Suspension);
+}
+
+bool UTankSuspensionSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UTankSuspensionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTankSuspensionSubsystem, STATGROUP_Tickables);
+}
+
+void UTankSuspensionSubsystem::Tick(float DeltaTime)
+{
+	UWorld* World = GetWorld();
+	Suspensions.RemoveAllSwap([](const UTankSuspensionComponent* Suspension) { return !IsValid(Suspension); });
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SuspensionConsume);
+		for (UTankSuspensionComponent* Suspension : Suspensions)
+		{
+			Suspension->ConsumeTraces(World, DeltaTime);
+		}
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SuspensionIssue);
+		for (UTankSuspensionComponent* Suspension : Suspensions)
+		{
+			Suspension->IssueTraces(World);
+		}
+	}
+}
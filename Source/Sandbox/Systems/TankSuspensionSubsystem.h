@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TankSuspensionSubsystem.generated.h"
+
+class UTankSuspensionComponent;
+
+/**
+ * Batches wheel casts for every tank.
+ * Each frame: consume last frame's async results into forces (applied on the next
+ * physics step), then issue the whole next batch of async sweeps at once.
+ */
+UCLASS()
+class SANDBOX_API UTankSuspensionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void Register(UTankSuspensionComponent* Suspension);
+	void Unregister(UTankSuspensionComponent* Suspension);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY()
+	TArray<TObjectPtr<UTankSuspensionComponent>> Suspensions;
+};
@@ -0,0 +1,66 @@
+#include "TankVisualsSubsystem.h"
+#include "Sandbox.h"
+#include "ViewSignificanceSubsystem.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("TankVisuals Compute"), STAT_TankVisualsCompute, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("TankVisuals Apply"), STAT_TankVisualsApply, STATGROUP_Game);
+
+void UTankVisualsSubsystem::Register(UTankBodyComponent* Body)
+{
+	if (Body)
+	{
+		Bodies.AddUnique(Body);
+	}
+}
+
+void UTankVisualsSubsystem::Unregister(UTankBodyComponent* Body)
+{
+	Bodies.RemoveSingleSwap(Body);
+}
+
+bool UTankVisualsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Servers have no treads; SetTurretAim keeps the pivots current for muzzle placement
+	return (WorldType == EWorldType::Game || WorldType == EWorldType::PIE) && !Sandbox::IsCosmeticDisabled();
+}
+
+TStatId UTankVisualsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTankVisualsSubsystem, STATGROUP_Tickables);
+}
+
+void UTankVisualsSubsystem::Tick(float DeltaTime)
+{
+	Bodies.RemoveAllSwap([](const UTankBodyComponent* Body) { return !IsValid(Body); });
+
+	const int32 Num = Bodies.Num();
+	if (Num == 0) return;
+
+	// Gather on the game thread (reads component transforms). Tread animation
+	// is skipped for tanks far from every local view - one check shared by all views.
+	UViewSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UViewSignificanceSubsystem>();
+	Jobs.SetNum(Num, EAllowShrinking::No);
+	for (int32 i = 0; i < Num; i++)
+	{
+		Bodies[i]->GatherVisualJob(Jobs[i]);
+		Jobs[i].bAnimateTreads = !Significance
+			|| Significance->GetSignificance(Bodies[i]->GetComponentLocation()) != EViewSignificance::Far;
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TankVisualsCompute);
+		ParallelFor(Num, [this, DeltaTime](int32 Index)
+		{
+			UTankBodyComponent::ComputeVisualJob(Jobs[Index], DeltaTime);
+		}, Num < MinParallelBodies ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TankVisualsApply);
+		for (int32 i = 0; i < Num; i++)
+		{
+			Bodies[i]->ApplyVisualJob(Jobs[i]);
+		}
+	}
+}
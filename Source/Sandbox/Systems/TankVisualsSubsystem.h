@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/TankBodyComponent.h"
+#include "TankVisualsSubsystem.generated.h"
+
+/**
+ * Batched tank visuals - tread animation and turret/barrel aim for every tank.
+ * Pawns only store targets during their Tick; this subsystem then gathers all bodies,
+ * computes tread and pivot transforms in one ParallelFor and applies them on the game thread.
+ */
+UCLASS()
+class SANDBOX_API UTankVisualsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void Register(UTankBodyComponent* Body);
+	void Unregister(UTankBodyComponent* Body);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	UPROPERTY()
+	TArray<TObjectPtr<UTankBodyComponent>> Bodies;
+
+	// Reused every frame, same order as Bodies
+	TArray<FTankVisualJob> Jobs;
+
+	// Below this many tanks the ParallelFor dispatch costs more than it saves
+	static constexpr int32 MinParallelBodies = 8;
+};
@@ -0,0 +1,44 @@
+#include "ViewSignificanceSubsystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+const TArray<FVector>& UViewSignificanceSubsystem::GetViewLocations()
+{
+	// Refreshed at most once per frame, however many callers ask
+	if (ViewFrame != GFrameCounter)
+	{
+		ViewFrame = GFrameCounter;
+		ViewLocations.Reset();
+
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PC = It->Get();
+			if (PC && PC->IsLocalController() && PC->PlayerCameraManager)
+			{
+				ViewLocations.Add(PC->PlayerCameraManager->GetCameraLocation());
+			}
+		}
+	}
+	return ViewLocations;
+}
+
+float UViewSignificanceSubsystem::GetNearestViewDistance(const FVector& Location)
+{
+	float NearestSq = MAX_flt;
+	for (const FVector& View : GetViewLocations())
+	{
+		NearestSq = FMath::Min(NearestSq, FVector::DistSquared(View, Location));
+	}
+	return NearestSq < MAX_flt ? FMath::Sqrt(NearestSq) : MAX_flt;
+}
+
+EViewSignificance UViewSignificanceSubsystem::GetSignificance(const FVector& Location)
+{
+	if (GetViewLocations().Num() == 0) return EViewSignificance::Near;
+
+	const float Distance = GetNearestViewDistance(Location);
+	if (Distance >= FarDistance) return EViewSignificance::Far;
+	if (Distance >= MidDistance) return EViewSignificance::Mid;
+	return EViewSignificance::Near;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ViewSignificanceSubsystem.generated.h"
+
+enum class EViewSignificance : uint8
+{
+	Near,
+	Mid,
+	Far
+};
+
+/**
+ * Cosmetic LOD shared by every local view.
+ * View locations are gathered once per frame from all local players; tread animation,
+ * debris counts, VFX and decals ask for the distance to the nearest view, so splitscreen
+ * adds rendering cost per view but no duplicated simulation or cosmetic work.
+ * With no local views (server, headless) everything is Near.
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UViewSignificanceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Distance from Location to the closest local view (MAX_flt if there are none)
+	float GetNearestViewDistance(const FVector& Location);
+
+	EViewSignificance GetSignificance(const FVector& Location);
+
+	const TArray<FVector>& GetViewLocations();
+
+private:
+	UPROPERTY(Config)
+	float MidDistance = 5000.f;
+
+	UPROPERTY(Config)
+	float FarDistance = 12000.f;
+
+	TArray<FVector> ViewLocations;
+	uint64 ViewFrame = MAX_uint64;
+};
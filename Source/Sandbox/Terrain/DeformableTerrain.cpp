@@ -0,0 +1,303 @@
+#include "DeformableTerrain.h"
+#include "DeformableTerrainSubsystem.h"
+#include "ProceduralMeshComponent.h"
+#include "Async/ParallelFor.h"
+#include "UObject/ConstructorHelpers.h"
+
+DECLARE_CYCLE_STAT(TEXT("Terrain Apply Tiles"), STAT_TerrainApplyTiles, STATGROUP_Game);
+
+ADeformableTerrain::ADeformableTerrain()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	static ConstructorHelpers::FObjectFinder<UMaterialInterface> GroundMat(
+		TEXT("/Engine/BasicShapes/BasicShapeMaterial.BasicShapeMaterial"));
+	Material = GroundMat.Object;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+}
+
+void ADeformableTerrain::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// === HEIGHTS ===
+	Heights.SetNumUninitialized(VertsX() * VertsY());
+	for (int32 Y = 0; Y < VertsY(); Y++)
+	{
+		for (int32 X = 0; X < VertsX(); X++)
+		{
+			const FVector2D P(X * QuadSize * NoiseScale, Y * QuadSize * NoiseScale);
+			Heights[Y * VertsX() + X] = NoiseAmplitude > 0.f ? FMath::PerlinNoise2D(P) * NoiseAmplitude : 0.f;
+		}
+	}
+
+	// === SHARED TOPOLOGY ===
+	const int32 N = TileQuads + 1;
+	TileTriangles.Reset(TileQuads * TileQuads * 6);
+	for (int32 Y = 0; Y < TileQuads; Y++)
+	{
+		for (int32 X = 0; X < TileQuads; X++)
+		{
+			const int32 I0 = Y * N + X;
+			const int32 I1 = I0 + 1;
+			const int32 I2 = I0 + N;
+			const int32 I3 = I2 + 1;
+			TileTriangles.Append({ I0, I1, I2, I1, I3, I2 });
+		}
+	}
+
+	// === TILES ===
+	const int32 NumTiles = TilesX * TilesY;
+	Tiles.SetNum(NumTiles);
+	for (int32 i = 0; i < NumTiles; i++)
+	{
+		UProceduralMeshComponent* Tile = NewObject<UProceduralMeshComponent>(this, *FString::Printf(TEXT("Tile_%d"), i));
+		Tile->bUseAsyncCooking = true;  // Collision rebuilds never stall the game thread
+		Tile->SetupAttachment(RootComponent);
+		Tile->SetRelativeLocation(FVector((i % TilesX) * TileQuads * QuadSize, (i / TilesX) * TileQuads * QuadSize, 0.f));
+		Tile->SetCollisionProfileName(TEXT("BlockAll"));
+		Tile->RegisterComponent();
+		Tiles[i] = Tile;
+	}
+
+	// Initial build for every tile in parallel, then create sections
+	TArray<TSharedPtr<FTerrainTileMesh>> Initial;
+	Initial.SetNum(NumTiles);
+	ParallelFor(NumTiles, [this, &Initial](int32 Tile)
+	{
+		Initial[Tile] = BuildTileMesh(SnapshotTile(Tile), TileQuads, QuadSize);
+	});
+	for (int32 i = 0; i < NumTiles; i++)
+	{
+		ApplyTileMesh(i, *Initial[i], true);
+	}
+
+	DirtyTiles.Init(false, NumTiles);
+
+	if (UDeformableTerrainSubsystem* Subsystem = GetWorld()->GetSubsystem<UDeformableTerrainSubsystem>())
+	{
+		Subsystem->Register(this);
+	}
+}
+
+void ADeformableTerrain::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UDeformableTerrainSubsystem* Subsystem = GetWorld()->GetSubsystem<UDeformableTerrainSubsystem>())
+	{
+		Subsystem->Unregister(this);
+	}
+
+	for (FTileBuild& Build : InFlight)
+	{
+		Build.Task.Wait();
+	}
+	InFlight.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+float ADeformableTerrain::HeightAtVertex(int32 X, int32 Y) const
+{
+	X = FMath::Clamp(X, 0, VertsX() - 1);
+	Y = FMath::Clamp(Y, 0, VertsY() - 1);
+	return Heights[Y * VertsX() + X];
+}
+
+bool ADeformableTerrain::ContainsXY(const FVector& WorldLocation) const
+{
+	const FVector Local = GetActorTransform().InverseTransformPosition(WorldLocation);
+	return Local.X >= 0.f && Local.Y >= 0.f
+		&& Local.X <= (VertsX() - 1) * QuadSize && Local.Y <= (VertsY() - 1) * QuadSize;
+}
+
+float ADeformableTerrain::GetHeightAt(const FVector& WorldLocation) const
+{
+	const FVector Local = GetActorTransform().InverseTransformPosition(WorldLocation);
+	const float FX = Local.X / QuadSize;
+	const float FY = Local.Y / QuadSize;
+	const int32 X = FMath::FloorToInt(FX);
+	const int32 Y = FMath::FloorToInt(FY);
+
+	const float H = FMath::BiLerp(
+		HeightAtVertex(X, Y), HeightAtVertex(X + 1, Y),
+		HeightAtVertex(X, Y + 1), HeightAtVertex(X + 1, Y + 1),
+		FX - X, FY - Y);
+
+	return GetActorTransform().TransformPosition(FVector(Local.X, Local.Y, H)).Z;
+}
+
+bool ADeformableTerrain::AddCrater(const FVector& WorldLocation, float Radius, float Depth)
+{
+	if (Heights.Num() == 0 || Radius <= 0.f || !ContainsXY(WorldLocation)) return false;
+
+	// Air bursts leave the ground alone
+	if (WorldLocation.Z - GetHeightAt(WorldLocation) > Radius) return false;
+
+	const FVector Local = GetActorTransform().InverseTransformPosition(WorldLocation);
+	const float RimRadius = Radius * 1.3f;
+
+	const int32 MinX = FMath::Max(0, FMath::FloorToInt((Local.X - RimRadius) / QuadSize));
+	const int32 MaxX = FMath::Min(VertsX() - 1, FMath::CeilToInt((Local.X + RimRadius) / QuadSize));
+	const int32 MinY = FMath::Max(0, FMath::FloorToInt((Local.Y - RimRadius) / QuadSize));
+	const int32 MaxY = FMath::Min(VertsY() - 1, FMath::CeilToInt((Local.Y + RimRadius) / QuadSize));
+
+	for (int32 Y = MinY; Y <= MaxY; Y++)
+	{
+		for (int32 X = MinX; X <= MaxX; X++)
+		{
+			const float Dist = FVector2D::Distance(FVector2D(X * QuadSize, Y * QuadSize), FVector2D(Local.X, Local.Y));
+			const float D = Dist / Radius;
+
+			float Delta = 0.f;
+			if (D < 1.f)
+			{
+				Delta = -Depth * (1.f - D * D);  // Bowl
+			}
+			else if (D < 1.3f)
+			{
+				Delta = Depth * 0.2f * FMath::Sin(PI * (D - 1.f) / 0.3f);  // Thrown-up rim
+			}
+
+			float& H = Heights[Y * VertsX() + X];
+			H = FMath::Max(H + Delta, -10.f * Depth);
+		}
+	}
+
+	MarkDirty(MinX, MinY, MaxX, MaxY);
+	return true;
+}
+
+void ADeformableTerrain::MarkDirty(int32 MinVX, int32 MinVY, int32 MaxVX, int32 MaxVY)
+{
+	// Neighbouring vertices feed the normals, so widen by one
+	MinVX--; MinVY--; MaxVX++; MaxVY++;
+
+	const int32 MinTX = FMath::Max(0, FMath::CeilToInt((float)(MinVX - TileQuads) / TileQuads));
+	const int32 MaxTX = FMath::Min(TilesX - 1, FMath::FloorToInt((float)MaxVX / TileQuads));
+	const int32 MinTY = FMath::Max(0, FMath::CeilToInt((float)(MinVY - TileQuads) / TileQuads));
+	const int32 MaxTY = FMath::Min(TilesY - 1, FMath::FloorToInt((float)MaxVY / TileQuads));
+
+	for (int32 TY = MinTY; TY <= MaxTY; TY++)
+	{
+		for (int32 TX = MinTX; TX <= MaxTX; TX++)
+		{
+			const int32 Tile = TY * TilesX + TX;
+			if (!DirtyTiles[Tile])
+			{
+				DirtyTiles[Tile] = true;
+				DirtyQueue.Add(Tile);
+			}
+		}
+	}
+}
+
+TArray<float> ADeformableTerrain::SnapshotTile(int32 Tile) const
+{
+	const int32 BaseX = (Tile % TilesX) * TileQuads;
+	const int32 BaseY = (Tile / TilesX) * TileQuads;
+	const int32 Side = TileQuads + 3;
+
+	TArray<float> Snapshot;
+	Snapshot.SetNumUninitialized(Side * Side);
+	for (int32 Y = 0; Y < Side; Y++)
+	{
+		for (int32 X = 0; X < Side; X++)
+		{
+			Snapshot[Y * Side + X] = HeightAtVertex(BaseX + X - 1, BaseY + Y - 1);
+		}
+	}
+	return Snapshot;
+}
+
+TSharedPtr<FTerrainTileMesh> ADeformableTerrain::BuildTileMesh(const TArray<float>& InHeights, int32 InTileQuads, float InQuadSize)
+{
+	const int32 N = InTileQuads + 1;
+	const int32 Side = InTileQuads + 3;
+	auto H = [&InHeights, Side](int32 X, int32 Y) { return InHeights[(Y + 1) * Side + (X + 1)]; };
+
+	TSharedPtr<FTerrainTileMesh> Mesh = MakeShared<FTerrainTileMesh>();
+	Mesh->Vertices.SetNumUninitialized(N * N);
+	Mesh->Normals.SetNumUninitialized(N * N);
+	Mesh->UV0.SetNumUninitialized(N * N);
+
+	for (int32 Y = 0; Y < N; Y++)
+	{
+		for (int32 X = 0; X < N; X++)
+		{
+			const int32 Index = Y * N + X;
+			Mesh->Vertices[Index] = FVector(X * InQuadSize, Y * InQuadSize, H(X, Y));
+
+			const float DX = H(X + 1, Y) - H(X - 1, Y);
+			const float DY = H(X, Y + 1) - H(X, Y - 1);
+			Mesh->Normals[Index] = FVector(-DX, -DY, 2.f * InQuadSize).GetSafeNormal();
+
+			Mesh->UV0[Index] = FVector2D((float)X / InTileQuads, (float)Y / InTileQuads);
+		}
+	}
+	return Mesh;
+}
+
+void ADeformableTerrain::ApplyTileMesh(int32 Tile, const FTerrainTileMesh& MeshData, bool bCreate)
+{
+	UProceduralMeshComponent* Component = Tiles[Tile];
+	if (!Component) return;
+
+	if (bCreate)
+	{
+		Component->CreateMeshSection(0, MeshData.Vertices, TileTriangles, MeshData.Normals, MeshData.UV0,
+			TArray<FColor>(), TArray<FProcMeshTangent>(), true);
+		Component->SetMaterial(0, Material);
+	}
+	else
+	{
+		// Same topology - only positions/normals change; collision is re-cooked async
+		Component->UpdateMeshSection(0, MeshData.Vertices, MeshData.Normals, MeshData.UV0,
+			TArray<FColor>(), TArray<FProcMeshTangent>());
+	}
+}
+
+void ADeformableTerrain::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Swap in finished tiles, a few per frame
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TerrainApplyTiles);
+		int32 Applied = 0;
+		for (int32 i = 0; i < InFlight.Num() && Applied < MaxAppliesPerFrame;)
+		{
+			if (!InFlight[i].Task.IsCompleted())
+			{
+				i++;
+				continue;
+			}
+
+			ApplyTileMesh(InFlight[i].Tile, *InFlight[i].Task.GetResult(), false);
+			InFlight.RemoveAtSwap(i);
+			Applied++;
+		}
+	}
+
+	// Launch rebuilds for dirty tiles that aren't already building
+	for (int32 q = 0; q < DirtyQueue.Num() && InFlight.Num() < MaxConcurrentBuilds;)
+	{
+		const int32 Tile = DirtyQueue[q];
+		if (InFlight.ContainsByPredicate([Tile](const FTileBuild& Build) { return Build.Tile == Tile; }))
+		{
+			q++;
+			continue;
+		}
+
+		DirtyQueue.RemoveAt(q);
+		DirtyTiles[Tile] = false;
+
+		FTileBuild& Build = InFlight.AddDefaulted_GetRef();
+		Build.Tile = Tile;
+		Build.Task = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+			[Snapshot = SnapshotTile(Tile), Quads = TileQuads, Size = QuadSize]()
+			{
+				return BuildTileMesh(Snapshot, Quads, Size);
+			});
+	}
+}
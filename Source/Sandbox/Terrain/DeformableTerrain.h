@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Tasks/Task.h"
+#include "DeformableTerrain.generated.h"
+
+class UProceduralMeshComponent;
+class UMaterialInterface;
+
+// Mesh data for one terrain tile, built on a worker thread
+struct FTerrainTileMesh
+{
+	TArray<FVector> Vertices;
+	TArray<FVector> Normals;
+	TArray<FVector2D> UV0;
+};
+
+/**
+ * Heightfield ground that explosions can crater.
+ * The height grid is split into tiles, each its own procedural mesh section with collision.
+ * Craters only dirty the tiles they touch; dirty tiles are rebuilt on worker threads and
+ * swapped in a few per frame, with collision cooked asynchronously.
+ */
+UCLASS()
+class SANDBOX_API ADeformableTerrain : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ADeformableTerrain();
+
+	virtual void Tick(float DeltaTime) override;
+
+	// Dig a bowl with a raised rim. Returns false if the point is off the terrain or too high above it.
+	bool AddCrater(const FVector& WorldLocation, float Radius, float Depth);
+
+	// Terrain height under a world XY (world Z)
+	float GetHeightAt(const FVector& WorldLocation) const;
+
+	bool ContainsXY(const FVector& WorldLocation) const;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	int32 VertsX() const { return TilesX * TileQuads + 1; }
+	int32 VertsY() const { return TilesY * TileQuads + 1; }
+	float HeightAtVertex(int32 X, int32 Y) const;
+
+	void MarkDirty(int32 MinVX, int32 MinVY, int32 MaxVX, int32 MaxVY);
+
+	// Copy the tile's heights (plus a 1-vertex border for normals) for a worker
+	TArray<float> SnapshotTile(int32 Tile) const;
+	static TSharedPtr<FTerrainTileMesh> BuildTileMesh(const TArray<float>& InHeights, int32 InTileQuads, float InQuadSize);
+	void ApplyTileMesh(int32 Tile, const FTerrainTileMesh& MeshData, bool bCreate);
+
+	UPROPERTY(EditAnywhere, Category = "Terrain")
+	int32 TilesX = 16;
+
+	UPROPERTY(EditAnywhere, Category = "Terrain")
+	int32 TilesY = 16;
+
+	// Quads per tile side
+	UPROPERTY(EditAnywhere, Category = "Terrain")
+	int32 TileQuads = 32;
+
+	UPROPERTY(EditAnywhere, Category = "Terrain")
+	float QuadSize = 100.f;
+
+	// Gentle rolling hills on start (0 = flat)
+	UPROPERTY(EditAnywhere, Category = "Terrain")
+	float NoiseAmplitude = 60.f;
+
+	UPROPERTY(EditAnywhere, Category = "Terrain")
+	float NoiseScale = 0.0004f;
+
+	UPROPERTY(EditAnywhere, Category = "Terrain")
+	UMaterialInterface* Material;
+
+	// Background tile rebuilds allowed at once
+	UPROPERTY(EditAnywhere, Category = "Terrain|Performance")
+	int32 MaxConcurrentBuilds = 4;
+
+	// Finished tiles swapped into render/collision per frame
+	UPROPERTY(EditAnywhere, Category = "Terrain|Performance")
+	int32 MaxAppliesPerFrame = 2;
+
+	UPROPERTY(Transient)
+	TArray<UProceduralMeshComponent*> Tiles;
+
+	// Heights in cm relative to the actor, row-major (VertsX x VertsY)
+	TArray<float> Heights;
+
+	// Index buffer shared by every tile (same grid topology)
+	TArray<int32> TileTriangles;
+
+	TBitArray<> DirtyTiles;
+	TArray<int32> DirtyQueue;
+
+	struct FTileBuild
+	{
+		int32 Tile = INDEX_NONE;
+		UE::Tasks::TTask<TSharedPtr<FTerrainTileMesh>> Task;
+	};
+	TArray<FTileBuild> InFlight;
+};
@@ -0,0 +1,14 @@
+#include "DeformableTerrainSubsystem.h"
+#include "DeformableTerrain.h"
+
+void UDeformableTerrainSubsystem::AddExplosionCrater(const FVector& Location, float ExplosionRadius)
+{
+	const float Radius = ExplosionRadius * CraterRadiusScale;
+	for (ADeformableTerrain* Terrain : Terrains)
+	{
+		if (Terrain && Terrain->AddCrater(Location, Radius, Radius * CraterDepthRatio))
+		{
+			return;
+		}
+	}
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DeformableTerrainSubsystem.generated.h"
+
+class ADeformableTerrain;
+
+/**
+ * Routes explosions to whichever deformable terrain lies under them.
+ */
+UCLASS(Config = Game)
+class SANDBOX_API UDeformableTerrainSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void Register(ADeformableTerrain* Terrain) { Terrains.AddUnique(Terrain); }
+	void Unregister(ADeformableTerrain* Terrain) { Terrains.Remove(Terrain); }
+
+	// Crater size is derived from the explosion radius
+	void AddExplosionCrater(const FVector& Location, float ExplosionRadius);
+
+private:
+	UPROPERTY(Config)
+	float CraterRadiusScale = 0.35f;
+
+	UPROPERTY(Config)
+	float CraterDepthRatio = 0.3f;
+
+	UPROPERTY()
+	TArray<ADeformableTerrain*> Terrains;
+};
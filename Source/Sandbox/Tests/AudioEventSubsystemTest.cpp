@@ -0,0 +1,55 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "AudioEventSubsystem.h"
+#include "SandboxTestWorld.h"
+
+// Flood every category far past its budget for a second of game time and check the
+// voice counts never exceed the configured maximums. Runs with -nullrhi / -nosound;
+// not on a dedicated server, which never posts audio.
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSandboxAudioVoiceBudgetTest, "Sandbox.Audio.VoiceBudget",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FSandboxAudioVoiceBudgetTest::RunTest(const FString& Parameters)
+{
+	FSandboxTestWorld TestWorld;
+	UAudioEventSubsystem* Audio = TestWorld.World->GetSubsystem<UAudioEventSubsystem>();
+	if (!TestNotNull(TEXT("Audio subsystem"), Audio)) return false;
+
+	const ESandboxSound Categories[] = { ESandboxSound::Shot, ESandboxSound::Explosion, ESandboxSound::Break };
+	const float DeltaTime = 1.f / 30.f;
+
+	for (int32 Frame = 0; Frame < 30; Frame++)
+	{
+		for (int32 i = 0; i < 40; i++)
+		{
+			// Spread out so explosions don't all merge into one, with mixed loudness to exercise stealing
+			const FVector Location(i * 1000.f, Frame * 100.f, 0.f);
+			const float Loudness = 0.5f + (i % 5) * 0.25f;
+			for (ESandboxSound Sound : Categories)
+			{
+				Audio->PostEvent(Sound, Location, Loudness);
+			}
+		}
+
+		TestWorld.Tick(DeltaTime);
+
+		for (ESandboxSound Sound : Categories)
+		{
+			const int32 Active = Audio->GetActiveVoices(Sound);
+			const int32 Max = Audio->GetMaxVoices(Sound);
+			if (Active > Max)
+			{
+				AddError(FString::Printf(TEXT("Frame %d: category %d has %d voices, budget %d"), Frame, (int32)Sound, Active, Max));
+			}
+		}
+	}
+
+	// A budget check that played nothing proves nothing
+	TestTrue(TEXT("Events were played"), Audio->GetNumPlayed() > 0);
+	TestTrue(TEXT("Excess events were dropped"), Audio->GetNumDropped() > 0);
+	return !HasAnyErrors();
+}
+
+#endif
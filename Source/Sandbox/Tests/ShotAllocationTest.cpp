@@ -0,0 +1,78 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "SandboxTestWorld.h"
+#include "ShotAllocationCounter.h"
+#include "Pawns/TankPawn.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+
+// Fire a tank at a wall until the shell and effect pools are warm, then count heap
+// allocations over a run of shots and fail if the average goes over the budget
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSandboxShotAllocationTest, "Sandbox.Projectiles.ShotAllocations",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+namespace
+{
+	constexpr int32 WarmupShots = 4;
+	constexpr int32 MeasuredShots = 16;
+	constexpr int32 AllocationBudget = 4;  // Per shot, same default as Sandbox.ShotAllocs Stop
+	constexpr float DeltaTime = 1.f / 30.f;
+
+	// Fire Count shots as fast as the cooldown allows, then let the last shell land.
+	// A second per shot is well over the tank's fire rate.
+	void FireVolley(FSandboxTestWorld& TestWorld, ATankPawn* Tank, int32 Count)
+	{
+		const int32 MaxFrames = FMath::CeilToInt((Count + 1) / DeltaTime);
+		int32 Fired = 0;
+		for (int32 Frame = 0; Frame < MaxFrames && Fired < Count; Frame++)
+		{
+			Fired += Tank->TryFire();
+			TestWorld.Tick(DeltaTime);
+		}
+		for (float Time = 0.f; Time < 1.f; Time += DeltaTime)
+		{
+			TestWorld.Tick(DeltaTime);
+		}
+	}
+}
+
+bool FSandboxShotAllocationTest::RunTest(const FString& Parameters)
+{
+	FSandboxTestWorld TestWorld;
+	UWorld* World = TestWorld.World;
+
+	// Wall 30 m downrange so every shell explodes rather than timing out
+	AStaticMeshActor* Wall = World->SpawnActor<AStaticMeshActor>(FVector(3000.f, 0.f, 200.f), FRotator::ZeroRotator);
+	UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!TestNotNull(TEXT("Wall"), Wall) || !TestNotNull(TEXT("Cube mesh"), Cube)) return false;
+	Wall->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+	Wall->GetStaticMeshComponent()->SetStaticMesh(Cube);
+	Wall->SetActorScale3D(FVector(1.f, 20.f, 20.f));
+
+	ATankPawn* Tank = World->SpawnActor<ATankPawn>(FVector(0.f, 0.f, 200.f), FRotator::ZeroRotator);
+	if (!TestNotNull(TEXT("Tank"), Tank)) return false;
+	Tank->SetAim(0.f, 0.f);
+
+	FireVolley(TestWorld, Tank, WarmupShots);
+
+	ShotAllocationCounter::Start();
+	FireVolley(TestWorld, Tank, MeasuredShots);
+	int64 Allocations = 0;
+	int32 Shots = 0;
+	ShotAllocationCounter::Stop(Allocations, Shots);
+
+	if (!TestTrue(TEXT("Measured shots finished"), Shots >= MeasuredShots)) return false;
+
+	const double PerShot = (double)Allocations / Shots;
+	AddInfo(FString::Printf(TEXT("%lld allocations over %d shots (%.2f/shot, budget %d)"), Allocations, Shots, PerShot, AllocationBudget));
+	if (PerShot > AllocationBudget)
+	{
+		AddError(FString::Printf(TEXT("%.2f allocations per shot is over the budget of %d"), PerShot, AllocationBudget));
+	}
+	return !HasAnyErrors();
+}
+
+#endif
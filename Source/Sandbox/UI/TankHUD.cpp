@@ -6,7 +6,7 @@ void ATankHUD::DrawHUD()
 	Super::DrawHUD();
 	if (!Canvas) return;
 
-	// Fixed crosshair at screen center
+	// Fixed crosshair at the center of this player's view (Canvas is the splitscreen viewport)
 	float CX = Canvas->SizeX * 0.5f;
 	float CY = Canvas->SizeY * 0.5f;
 